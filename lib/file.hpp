@@ -1,13 +1,15 @@
 #pragma once
 
-namespace sys
-{
-
+// Included globally: standard headers may pull these in first
 #include <sys/file.h>
+#include <sys/stat.h>
 
 #include <fcntl.h>
 #include <unistd.h>
 
+namespace sys
+{
+
 namespace file
 {
 
@@ -18,11 +20,22 @@ using descriptor  = sint_t;
 using flag_code   = sint_t;
 using status_code = sint_t;
 
-inline auto &open   = sys::open;
-inline auto &lock   = sys::flock;
-inline auto &unlock = sys::flock;
-inline auto &resize = sys::ftruncate;
-inline auto &close  = sys::close;
+inline auto &open     = ::open;
+inline auto &lock     = ::flock;
+inline auto &unlock   = ::flock;
+inline auto &control  = ::fcntl;
+inline auto &resize   = ::ftruncate;
+inline auto &allocate = ::fallocate;
+inline auto &seek     = ::lseek;
+inline auto &status   = ::fstat;
+inline auto &read     = ::pread;
+inline auto &write    = ::pwrite;
+inline auto &close    = ::close;
+
+// durability
+inline auto &sync      = ::fdatasync;
+inline auto &sync_all  = ::fsync;
+inline auto &writeback = ::sync_file_range;
 
 } // memory namespace
 
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <linux/futex.h>
+
+#include <cstdint>
+#include <ctime>
+
+namespace sys
+{
+
+namespace futex
+{
+
+using status_code = signed long;
+using count_type  = signed int;
+
+// Shared futexes only: waiters and wakers may live in different processes
+inline status_code wait
+(
+    std::uint32_t         *address,
+    std::uint32_t          expected,
+    const struct timespec *timeout
+)
+{
+    return ::syscall(SYS_futex, address, FUTEX_WAIT, expected, timeout, nullptr, 0);
+}
+
+inline status_code wake
+(
+    std::uint32_t *address,
+    count_type     count
+)
+{
+    return ::syscall(SYS_futex, address, FUTEX_WAKE, count, nullptr, nullptr, 0);
+}
+
+} // futex namespace
+
+} // system namespace
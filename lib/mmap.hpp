@@ -1,5 +1,7 @@
 #pragma once
 
+#include <unistd.h>
+
 namespace sys
 {
 
@@ -26,6 +28,12 @@ inline auto &protect = mprotect;
 inline auto &advise   = madvise;
 inline auto &resident = mincore;
 
+// anonymous files
+inline auto &create = memfd_create;
+
+// system
+inline const long page_size = ::sysconf(_SC_PAGESIZE);
+
 namespace shared
 {
 
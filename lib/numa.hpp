@@ -0,0 +1,52 @@
+#pragma once
+
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace sys
+{
+
+namespace numa
+{
+
+using status_code = signed long;
+using flag_code   = signed int;
+using node_mask   = unsigned long;
+
+// memory policies
+constexpr flag_code POLICY_DEFAULT    = 0;
+constexpr flag_code POLICY_PREFERRED  = 1;
+constexpr flag_code POLICY_BIND       = 2;
+constexpr flag_code POLICY_INTERLEAVE = 3;
+
+// policy flags
+constexpr flag_code MOVE_PAGES = 1 << 1;
+
+// placement
+inline status_code bind
+(
+    void            *address,
+    unsigned long    length,
+    flag_code        policy,
+    const node_mask *nodes,
+    unsigned long    max_node,
+    flag_code        flags
+)
+{
+    return ::syscall(SYS_mbind, address, length, policy, nodes, max_node, flags);
+}
+
+// calling thread policy; decides where page cache pages it faults land
+inline status_code policy
+(
+    flag_code        policy,
+    const node_mask *nodes,
+    unsigned long    max_node
+)
+{
+    return ::syscall(SYS_set_mempolicy, policy, nodes, max_node);
+}
+
+} // numa namespace
+
+} // system namespace
@@ -0,0 +1,25 @@
+#pragma once
+
+// Included globally: standard headers may pull these in first
+#include <sys/socket.h>
+#include <sys/un.h>
+
+namespace sys
+{
+
+namespace socket
+{
+
+using status_code = signed long;
+using flag_code   = signed int;
+
+// connection
+inline auto &pair = ::socketpair;
+
+// messages & ancillary data
+inline auto &send    = ::sendmsg;
+inline auto &receive = ::recvmsg;
+
+} // socket namespace
+
+} // system namespace
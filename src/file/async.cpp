@@ -0,0 +1,130 @@
+#include <algorithm>
+#include <thread>
+
+#include <util/record.hpp>
+
+#include "async.hpp"
+
+
+namespace
+{
+
+// Workers for blocking mapping calls; sized for I/O rather than compute
+constexpr mmap::size_type MINIMUM_IO_WORKERS = 4;
+
+} // anonymous namespace
+
+
+util::thread::pool &
+mmap::async::executor() noexcept
+{
+    static util::thread::pool pool
+    (
+        std::max<mmap::size_type>(MINIMUM_IO_WORKERS, std::thread::hardware_concurrency())
+    );
+
+    return pool;
+}
+
+
+mmap::async::operation<mmap::address_type>
+mmap::async::open
+(
+    file &mapping
+) noexcept
+{
+    return operation<address_type>
+    (
+        [&mapping]() { return mapping.open(); }
+    );
+}
+
+mmap::async::operation<mmap::status_code>
+mmap::async::flush
+(
+    file &mapping
+) noexcept
+{
+    return operation<status_code>
+    (
+        [&mapping]() { return mapping.flush(); }
+    );
+}
+
+mmap::async::operation<mmap::address_type>
+mmap::async::remap
+(
+    file            &mapping,
+    const size_type  file_capacity
+) noexcept
+{
+    return operation<address_type>
+    (
+        [&mapping, file_capacity]() { return mapping.remap(file_capacity); }
+    );
+}
+
+mmap::async::operation<mmap::status_code>
+mmap::async::prefetch
+(
+    file            &mapping,
+    const size_type  offset,
+    const size_type  length
+) noexcept
+{
+    return operation<status_code>
+    (
+        [&mapping, offset, length]() -> status_code
+        {
+            // Check if mapped
+            if (!mapping.address())
+            {
+                util::log::record
+                (
+                    "Memory is not yet mapped",
+                    util::log::type::ERROR
+                );
+
+                return mmap::EXTERNAL_ERROR_CODE;
+            }
+
+            // Clamp to whole pages of mapping
+            const size_type page_size = sys::memory::page_size;
+            const size_type capacity  = mapping.capacity();
+            const size_type first     = std::min(offset, capacity) / page_size * page_size;
+            const size_type last      = std::min(offset + length, capacity);
+            if (first >= last)
+                return mmap::GLOBAL_SUCCESS_CODE;
+
+            // Fault range in now; read faults never dirty pages
+            sys::memory::status_code advise_status = sys::memory::advise
+            (
+                static_cast<std::uint8_t *>(mapping.address()) + first,
+                last - first,
+                MADV_POPULATE_READ
+            );
+            if (advise_status == mmap::INTERNAL_ERROR_CODE)
+            {
+                // Older kernels only start asynchronous read-ahead
+                advise_status = sys::memory::advise
+                (
+                    static_cast<std::uint8_t *>(mapping.address()) + first,
+                    last - first,
+                    MADV_WILLNEED
+                );
+            }
+            if (advise_status == mmap::INTERNAL_ERROR_CODE)
+            {
+                util::log::record
+                (
+                    "Unable to prefetch range of mapping",
+                    util::log::type::ERROR
+                );
+
+                return mmap::EXTERNAL_ERROR_CODE;
+            }
+
+            return mmap::GLOBAL_SUCCESS_CODE;
+        }
+    );
+}
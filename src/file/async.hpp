@@ -0,0 +1,78 @@
+#pragma once
+
+#include <coroutine>
+#include <functional>
+
+#include <util/pool.hpp>
+
+#include "file/file.hpp"
+
+
+namespace mmap
+{
+
+namespace async
+{
+
+// Awaitable running blocking work on the I/O pool; the awaiting
+// coroutine resumes on the pool thread that finished the work
+template <typename result_type>
+class operation
+{
+private:
+    std::function<result_type()> work;
+    result_type                  result{};
+
+public:
+    explicit operation
+    (
+        std::function<result_type()> &&work
+    ) noexcept;
+
+    bool
+    await_ready() const noexcept;
+    bool
+    await_suspend
+    (
+        std::coroutine_handle<> handle
+    ) noexcept;
+    result_type
+    await_resume() noexcept;
+};
+
+// Shared pool all asynchronous file operations run on
+util::thread::pool &
+executor() noexcept;
+
+operation<address_type>
+open
+(
+    file &mapping
+) noexcept;
+
+operation<status_code>
+flush
+(
+    file &mapping
+) noexcept;
+
+operation<address_type>
+remap
+(
+    file            &mapping,
+    const size_type  file_capacity
+) noexcept;
+
+operation<status_code>
+prefetch
+(
+    file            &mapping,
+    const size_type  offset,
+    const size_type  length
+) noexcept;
+
+} // async namespace
+
+} // mmap namespace
+
+#include "file/async.tpp"
@@ -0,0 +1,51 @@
+#include <utility>
+
+
+template <typename result_type>
+mmap::async::operation<result_type>::operation
+(
+    std::function<result_type()> &&work
+) noexcept
+{
+    this->work = std::move(work);
+}
+
+template <typename result_type>
+bool
+mmap::async::operation<result_type>::await_ready() const noexcept
+{
+    return false;
+}
+
+template <typename result_type>
+bool
+mmap::async::operation<result_type>::await_suspend
+(
+    std::coroutine_handle<> handle
+) noexcept
+{
+    bool submitted = mmap::async::executor().submit
+    (
+        [this, handle]()
+        {
+            this->result = this->work();
+            handle.resume();
+        }
+    );
+
+    // Pool refused the work; run it here and continue without suspending
+    if (!submitted)
+    {
+        this->result = this->work();
+        return false;
+    }
+
+    return true;
+}
+
+template <typename result_type>
+result_type
+mmap::async::operation<result_type>::await_resume() noexcept
+{
+    return this->result;
+}
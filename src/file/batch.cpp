@@ -0,0 +1,182 @@
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <sstream>
+#include <string>
+
+#include <sys/resource.h>
+
+#include <util/pool.hpp>
+#include <util/record.hpp>
+
+#include "batch.hpp"
+
+
+namespace
+{
+
+// Remaining descriptors under the soft limit, less a reserve
+mmap::size_type
+default_budget() noexcept
+{
+    rlimit limit;
+    if (getrlimit(RLIMIT_NOFILE, &limit) == mmap::INTERNAL_ERROR_CODE)
+        return mmap::batch::DESCRIPTOR_RESERVE;
+
+    if (limit.rlim_cur == RLIM_INFINITY)
+        return static_cast<mmap::size_type>(-1);
+
+    return limit.rlim_cur > 2 * mmap::batch::DESCRIPTOR_RESERVE
+        ? limit.rlim_cur - mmap::batch::DESCRIPTOR_RESERVE
+        : limit.rlim_cur / 2;
+}
+
+} // anonymous namespace
+
+
+mmap::batch::open_report
+mmap::batch::open
+(
+    const std::vector<open_spec> &specs,
+    const size_type               thread_count,
+    const size_type               descriptor_budget,
+    const bool                    all_or_nothing
+) noexcept
+{
+    using clock = std::chrono::steady_clock;
+
+    open_report report;
+    const clock::time_point batch_start = clock::now();
+
+    try
+    {
+        report.results.resize(specs.size());
+    }
+
+    catch (const std::exception &exception)
+    {
+        util::log::record
+        (
+            "Unable to allocate results for batch open",
+            util::log::type::ERROR
+        );
+
+        report.failed = specs.size();
+        return report;
+    }
+
+    // Every mapped file keeps its descriptor for locking and resizing
+    const size_type budget = descriptor_budget ? descriptor_budget : default_budget();
+    if (specs.size() > budget)
+    {
+        std::stringstream stream;
+        stream << "Batch of " << specs.size() << " files exceeds descriptor budget of "
+            << budget << "; remaining files are not opened";
+
+        util::log::record
+        (
+            stream.str(),
+            util::log::type::FLAG
+        );
+    }
+    const size_type admitted = std::min(specs.size(), budget);
+
+    // Open admitted specs concurrently; unopened specs count as failed
+    try
+    {
+        util::thread::pool workers(std::max<size_type>(1, std::min(thread_count, admitted)));
+        for (size_type index = 0; index < admitted; ++index)
+        {
+            const open_spec &spec   = specs[index];
+            open_result     &result = report.results[index];
+
+            bool submitted = workers.submit
+            (
+                [&spec, &result]()
+                {
+                    const clock::time_point start = clock::now();
+
+                    try
+                    {
+                        result.mapping = std::make_unique<file>
+                        (
+                            spec.file_path,
+                            spec.file_size,
+                            spec.file_offset,
+                            nullptr,
+                            spec.open_flag,
+                            spec.lock_flag,
+                            spec.protocol_flag,
+                            spec.mapping_flag
+                        );
+
+                        result.address = result.mapping->open();
+                        if (result.address)
+                            result.status = mmap::GLOBAL_SUCCESS_CODE;
+                        else
+                            result.mapping.reset();
+                    }
+
+                    catch (const std::exception &exception)
+                    {
+                        result.mapping.reset();
+                    }
+
+                    result.duration = clock::now() - start;
+                }
+            );
+            if (!submitted)
+            {
+                util::log::record
+                (
+                    "Unable to queue file for batch open: " + spec.file_path,
+                    util::log::type::ERROR
+                );
+            }
+        }
+        workers.wait();
+    }
+
+    catch (...)
+    {
+        util::log::record
+        (
+            "Unable to start workers for batch open",
+            util::log::type::ERROR
+        );
+    }
+
+    // Aggregate
+    for (const open_result &result: report.results)
+    {
+        if (result.status == mmap::GLOBAL_SUCCESS_CODE)
+            ++report.opened;
+        else
+            ++report.failed;
+
+        report.total_duration += result.duration;
+    }
+
+    // Roll back a partial batch
+    if (all_or_nothing && report.failed && report.opened)
+    {
+        for (open_result &result: report.results)
+        {
+            result.mapping.reset();
+            result.address = nullptr;
+            result.status  = mmap::EXTERNAL_ERROR_CODE;
+        }
+
+        util::log::record
+        (
+            "Batch open rolled back " + std::to_string(report.opened) + " opened file(s)",
+            util::log::type::FLAG
+        );
+
+        report.failed += report.opened;
+        report.opened  = 0;
+    }
+    report.wall_duration = clock::now() - batch_start;
+
+    return report;
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "file/file.hpp"
+
+
+namespace mmap
+{
+
+namespace batch
+{
+
+using duration_type = std::chrono::nanoseconds;
+
+// Descriptors kept back for the rest of the process when deriving a budget
+constexpr size_type DESCRIPTOR_RESERVE = 64;
+
+// One file to open and map
+struct open_spec
+{
+    std::string            file_path;
+    size_type              file_size;
+    size_type              file_offset   = 0;
+
+    sys::file::flag_code   open_flag     = O_RDWR | O_CREAT;
+    sys::file::flag_code   lock_flag     = LOCK_SH;
+    sys::memory::flag_code protocol_flag = PROT_READ | PROT_WRITE;
+    sys::memory::flag_code mapping_flag  = MAP_SHARED;
+};
+
+// Outcome of one spec, in spec order; the caller owns each opened mapping
+// and releases it by resetting or destroying the result
+struct open_result
+{
+    std::unique_ptr<file> mapping;
+    address_type          address  = nullptr;
+    status_code           status   = mmap::EXTERNAL_ERROR_CODE;
+    duration_type         duration = duration_type::zero();
+};
+
+struct open_report
+{
+    std::vector<open_result> results;
+
+    size_type                opened         = 0;
+    size_type                failed         = 0;
+    duration_type            wall_duration  = duration_type::zero();
+    duration_type            total_duration = duration_type::zero();
+};
+
+// Open, lock, resize and map many files on a bounded pool; a zero
+// descriptor budget derives one from the process descriptor limit. With
+// all_or_nothing any failure closes the files that did open, though files
+// the batch created are left on disk
+open_report
+open
+(
+    const std::vector<open_spec> &specs,
+    const size_type               thread_count,
+    const size_type               descriptor_budget = 0,
+    const bool                    all_or_nothing    = false
+) noexcept;
+
+} // batch namespace
+
+} // mmap namespace
@@ -0,0 +1,348 @@
+#include <algorithm>
+#include <exception>
+#include <string>
+
+#include <util/record.hpp>
+
+#include "bitmap.hpp"
+
+
+namespace
+{
+
+// Resolved once at load time to the popcnt instruction where available
+__attribute__((target_clones("popcnt", "default")))
+mmap::size_type
+popcount
+(
+    const std::uint64_t *words,
+    const mmap::size_type count
+) noexcept
+{
+    mmap::size_type total = 0;
+    for (mmap::size_type index = 0; index < count; ++index)
+        total += __builtin_popcountll(words[index]);
+
+    return total;
+}
+
+// Position of zero-based rank-th set bit within word
+mmap::size_type
+select_word
+(
+    std::uint64_t   word,
+    mmap::size_type rank
+) noexcept
+{
+    while (rank--)
+        word &= word - 1;
+
+    return __builtin_ctzll(word);
+}
+
+} // anonymous namespace
+
+
+mmap::bitmap::bitmap
+(
+    // Required parameters
+    const std::string &file_path,
+    const size_type    bit_count
+):  words
+    (
+        file_path,
+        std::max<size_type>(1, (bit_count + mmap::BITMAP_WORD_BITS - 1) / mmap::BITMAP_WORD_BITS),
+        0,
+        nullptr,
+        O_RDWR | O_CREAT,
+        LOCK_SH,
+        PROT_READ | PROT_WRITE,
+        MAP_SHARED,
+        MS_ASYNC,
+        MREMAP_MAYMOVE,
+        mmap::NO_ALLOCATE,
+        true
+    )
+{
+    // metadata
+    this->bit_count = bit_count;
+}
+
+
+mmap::status_code
+mmap::bitmap::open() noexcept
+{
+    if (!this->words.open())
+    {
+        util::log::record
+        (
+            "Unable to open bitmap",
+            util::log::type::ERROR
+        );
+
+        return mmap::EXTERNAL_ERROR_CODE;
+    }
+
+    // Fresh file is zero filled by resize; existing file must agree on length
+    const size_type word_count = (this->bit_count + mmap::BITMAP_WORD_BITS - 1)
+        / mmap::BITMAP_WORD_BITS;
+    if (!this->words.count())
+        this->words.count(word_count);
+
+    else if (this->words.count() != word_count)
+    {
+        util::log::record
+        (
+            "Bitmap file holds a different number of bits",
+            util::log::type::ERROR
+        );
+
+        this->words.close();
+        return mmap::EXTERNAL_ERROR_CODE;
+    }
+    this->reindex();
+
+    return mmap::GLOBAL_SUCCESS_CODE;
+}
+
+mmap::status_code
+mmap::bitmap::flush() noexcept
+{
+    return this->words.flush();
+}
+
+mmap::status_code
+mmap::bitmap::close() noexcept
+{
+    this->rank_index.clear();
+    this->reindex();
+
+    return this->words.close();
+}
+
+
+bool
+mmap::bitmap::set
+(
+    const size_type bit
+) noexcept
+{
+    if (!this->valid_bit(bit))
+        return false;
+
+    const std::uint64_t mask = std::uint64_t(1) << (bit % mmap::BITMAP_WORD_BITS);
+    const std::uint64_t previous = this->word(bit / mmap::BITMAP_WORD_BITS)
+        .fetch_or(mask, std::memory_order_acq_rel);
+
+    if (!(previous & mask))
+        this->reindex();
+
+    return previous & mask;
+}
+
+bool
+mmap::bitmap::reset
+(
+    const size_type bit
+) noexcept
+{
+    if (!this->valid_bit(bit))
+        return false;
+
+    const std::uint64_t mask = std::uint64_t(1) << (bit % mmap::BITMAP_WORD_BITS);
+    const std::uint64_t previous = this->word(bit / mmap::BITMAP_WORD_BITS)
+        .fetch_and(~mask, std::memory_order_acq_rel);
+
+    if (previous & mask)
+        this->reindex();
+
+    return previous & mask;
+}
+
+bool
+mmap::bitmap::test
+(
+    const size_type bit
+) const noexcept
+{
+    if (!this->valid_bit(bit))
+        return false;
+
+    const std::uint64_t mask = std::uint64_t(1) << (bit % mmap::BITMAP_WORD_BITS);
+
+    return this->word(bit / mmap::BITMAP_WORD_BITS).load(std::memory_order_acquire) & mask;
+}
+
+
+mmap::size_type
+mmap::bitmap::size() const noexcept
+{
+    return this->bit_count;
+}
+
+mmap::size_type
+mmap::bitmap::count() const noexcept
+{
+    return popcount(this->words.data(), this->words.count());
+}
+
+mmap::size_type
+mmap::bitmap::rank
+(
+    const size_type bit
+) noexcept
+{
+    const size_type limit = std::min(bit, this->bit_count);
+    const size_type whole = limit / mmap::BITMAP_WORD_BITS;
+    const size_type line  = whole / mmap::BITMAP_LINE_WORDS;
+
+    // Whole lines from index when available, otherwise counted directly
+    size_type total = 0;
+    try
+    {
+        this->build_index();
+        total = this->rank_index[line];
+    }
+
+    catch (const std::exception &exception)
+    {
+        total = popcount(this->words.data(), line * mmap::BITMAP_LINE_WORDS);
+    }
+
+    total += popcount
+    (
+        this->words.data() + line * mmap::BITMAP_LINE_WORDS,
+        whole - line * mmap::BITMAP_LINE_WORDS
+    );
+
+    const size_type remainder = limit % mmap::BITMAP_WORD_BITS;
+    if (remainder)
+    {
+        const std::uint64_t mask = (std::uint64_t(1) << remainder) - 1;
+        total += __builtin_popcountll(this->words[whole] & mask);
+    }
+
+    return total;
+}
+
+mmap::size_type
+mmap::bitmap::select
+(
+    const size_type rank
+) noexcept
+{
+    try
+    {
+        this->build_index();
+    }
+
+    catch (const std::exception &exception)
+    {
+        util::log::record
+        (
+            "Unable to build bitmap rank index",
+            util::log::type::ERROR
+        );
+
+        return mmap::INVALID_BIT;
+    }
+
+    // Last line whose preceding count does not exceed rank
+    auto upper = std::upper_bound(this->rank_index.begin(), this->rank_index.end(), rank);
+    if (upper == this->rank_index.begin())
+        return mmap::INVALID_BIT;
+
+    size_type line      = (upper - this->rank_index.begin()) - 1;
+    size_type remaining = rank - this->rank_index[line];
+
+    // Scan words of that line
+    const size_type word_count = this->words.count();
+    for (size_type index = line * mmap::BITMAP_LINE_WORDS;
+         index < std::min(word_count, (line + 1) * mmap::BITMAP_LINE_WORDS); ++index)
+    {
+        const std::uint64_t value = this->words[index];
+        const size_type     bits  = __builtin_popcountll(value);
+        if (remaining < bits)
+        {
+            const size_type position = index * mmap::BITMAP_WORD_BITS
+                + select_word(value, remaining);
+
+            return position < this->bit_count ? position : mmap::INVALID_BIT;
+        }
+        remaining -= bits;
+    }
+
+    return mmap::INVALID_BIT;
+}
+
+void
+mmap::bitmap::reindex() noexcept
+{
+    this->rank_stale.store(true, std::memory_order_release);
+}
+
+
+bool
+mmap::bitmap::valid_bit
+(
+    const size_type bit
+) const noexcept
+{
+    // Check if mapped and within bitmap
+    if (!this->words.data() || bit >= this->bit_count)
+    {
+        util::log::record
+        (
+            "Bit index exceeds bitmap size",
+            util::log::type::ERROR
+        );
+
+        return false;
+    }
+
+    return true;
+}
+
+std::atomic<std::uint64_t> &
+mmap::bitmap::word
+(
+    const size_type index
+) const noexcept
+{
+    return *reinterpret_cast<std::atomic<std::uint64_t> *>(&this->words[index]);
+}
+
+void
+mmap::bitmap::build_index()
+{
+    if (!this->rank_stale.exchange(false, std::memory_order_acq_rel))
+        return;
+
+    // One entry per line plus a final total
+    const size_type word_count = this->words.count();
+    const size_type line_count = (word_count + mmap::BITMAP_LINE_WORDS - 1) / mmap::BITMAP_LINE_WORDS;
+    try
+    {
+        this->rank_index.resize(line_count + 1);
+    }
+
+    catch (const std::exception &exception)
+    {
+        this->reindex();
+        throw;
+    }
+
+    size_type total = 0;
+    for (size_type line = 0; line < line_count; ++line)
+    {
+        this->rank_index[line] = total;
+
+        const size_type first = line * mmap::BITMAP_LINE_WORDS;
+        total += popcount
+        (
+            this->words.data() + first,
+            std::min(mmap::BITMAP_LINE_WORDS, word_count - first)
+        );
+    }
+    this->rank_index[line_count] = total;
+}
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "file/ordered_file.hpp"
+
+
+namespace mmap
+{
+
+constexpr size_type BITMAP_WORD_BITS = 64;
+constexpr size_type BITMAP_LINE_WORDS = 8;  // one cache line per rank entry
+constexpr size_type INVALID_BIT       = static_cast<size_type>(-1);
+
+// Fixed-length bit array persisted in a described file; bit updates are
+// atomic so threads and processes sharing the mapping may set concurrently
+class bitmap
+{
+private:
+    // Backing mapping of 64-bit words
+    ordered_file<std::uint64_t> words;
+    size_type                   bit_count;
+
+    // Cumulative set bits before each cache line; rebuilt on demand
+    std::vector<size_type>      rank_index;
+    std::atomic<bool>           rank_stale{true};
+
+public:
+    bitmap
+    (
+        // Required parameters
+        const std::string &file_path,
+        const size_type    bit_count
+    );
+
+    virtual ~bitmap() noexcept = default;
+
+    // No copies permitted
+    bitmap(const bitmap &other)           = delete;
+    bitmap operator=(const bitmap &other) = delete;
+
+    status_code
+    virtual open() noexcept;
+    status_code
+    virtual flush() noexcept;
+    status_code
+    virtual close() noexcept;
+
+    // Return previous value of the bit; false for bits out of range
+    bool
+    set
+    (
+        const size_type bit
+    ) noexcept;
+    bool
+    reset
+    (
+        const size_type bit
+    ) noexcept;
+    bool
+    test
+    (
+        const size_type bit
+    ) const noexcept;
+
+    size_type
+    size() const noexcept;
+
+    // Set bits in whole bitmap
+    size_type
+    count() const noexcept;
+
+    // Set bits in [0, bit); rank and select share an index, so callers
+    // running them from several threads serialize between themselves
+    size_type
+    rank
+    (
+        const size_type bit
+    ) noexcept;
+
+    // Position of zero-based rank-th set bit, or INVALID_BIT
+    size_type
+    select
+    (
+        const size_type rank
+    ) noexcept;
+
+    // Discard rank index after bits were changed through another mapping
+    void
+    reindex() noexcept;
+
+protected:
+    bool
+    valid_bit
+    (
+        const size_type bit
+    ) const noexcept;
+    std::atomic<std::uint64_t> &
+    word
+    (
+        const size_type index
+    ) const noexcept;
+
+    void
+    build_index();
+};
+
+} // mmap namespace
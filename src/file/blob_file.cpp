@@ -0,0 +1,233 @@
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#include <util/record.hpp>
+
+#include "blob_file.hpp"
+
+
+mmap::blob_file::blob_file
+(
+    // Required parameters
+    const std::string &file_path,
+
+    // Advanced parameters
+    const size_type    index_capacity,
+    const size_type    heap_capacity,
+
+    // Layout flags
+    const bool         inline_flag
+):  index
+    (
+        file_path + ".index",
+        std::max<size_type>(1, index_capacity),
+        0,
+        nullptr,
+        O_RDWR | O_CREAT,
+        LOCK_SH,
+        PROT_READ | PROT_WRITE,
+        MAP_SHARED,
+        MS_ASYNC,
+        MREMAP_MAYMOVE,
+        mmap::NO_ALLOCATE,
+        true
+    ),
+    heap
+    (
+        file_path + ".heap",
+        std::max<size_type>(1, heap_capacity),
+        0,
+        nullptr,
+        O_RDWR | O_CREAT,
+        LOCK_SH,
+        PROT_READ | PROT_WRITE,
+        MAP_SHARED,
+        MS_ASYNC,
+        MREMAP_MAYMOVE,
+        mmap::NO_ALLOCATE,
+        true
+    )
+{
+    // flags
+    this->inline_flag = inline_flag;
+}
+
+
+mmap::status_code
+mmap::blob_file::open() noexcept
+{
+    // Map index
+    if (!this->index.open())
+    {
+        util::log::record
+        (
+            "Unable to open blob index",
+            util::log::type::ERROR
+        );
+
+        return mmap::EXTERNAL_ERROR_CODE;
+    }
+
+    // Map heap
+    if (!this->heap.open())
+    {
+        util::log::record
+        (
+            "Unable to open blob heap",
+            util::log::type::ERROR
+        );
+
+        this->index.close();
+        return mmap::EXTERNAL_ERROR_CODE;
+    }
+
+    return mmap::GLOBAL_SUCCESS_CODE;
+}
+
+mmap::status_code
+mmap::blob_file::flush() noexcept
+{
+    // Payloads reach file before the slots that reference them
+    if (this->heap.flush() == mmap::EXTERNAL_ERROR_CODE)
+        return mmap::EXTERNAL_ERROR_CODE;
+
+    return this->index.flush();
+}
+
+mmap::status_code
+mmap::blob_file::close() noexcept
+{
+    mmap::status_code heap_status  = this->heap.close();
+    mmap::status_code index_status = this->index.close();
+
+    if (heap_status == mmap::EXTERNAL_ERROR_CODE || index_status == mmap::EXTERNAL_ERROR_CODE)
+        return mmap::EXTERNAL_ERROR_CODE;
+
+    return mmap::GLOBAL_SUCCESS_CODE;
+}
+
+
+std::string_view
+mmap::blob_file::get
+(
+    const blob_id id
+) const noexcept
+{
+    if (id >= this->index.count())
+        return {};
+
+    const blob_entry &entry = this->index[id];
+    if (entry.inlined)
+        return std::string_view(entry.bytes, entry.length);
+
+    return std::string_view(this->heap.data() + entry.offset, entry.length);
+}
+
+mmap::blob_id
+mmap::blob_file::append
+(
+    const std::string_view payload
+) noexcept
+{
+    // Check if mapped
+    if (!this->index.address() || !this->heap.address())
+    {
+        util::log::record
+        (
+            "Memory is not yet mapped",
+            util::log::type::ERROR
+        );
+
+        return mmap::INVALID_BLOB;
+    }
+
+    // Slot length is 32 bits; refuse before anything is written
+    if (payload.size() > UINT32_MAX)
+    {
+        util::log::record
+        (
+            "Blob payload exceeds maximum length",
+            util::log::type::ERROR
+        );
+
+        return mmap::INVALID_BLOB;
+    }
+
+    const blob_id id = this->index.count();
+    if (this->reserve(this->index, id + 1) == mmap::EXTERNAL_ERROR_CODE)
+        return mmap::INVALID_BLOB;
+
+    blob_entry entry = {};
+    entry.length = static_cast<std::uint32_t>(payload.size());
+
+    // Short payloads skip the heap entirely
+    if (this->inline_flag && payload.size() <= mmap::BLOB_INLINE_BYTES)
+    {
+        entry.inlined = 1;
+        std::memcpy(entry.bytes, payload.data(), payload.size());
+    }
+
+    else
+    {
+        const size_type offset = this->heap.count();
+        if (this->reserve(this->heap, offset + payload.size()) == mmap::EXTERNAL_ERROR_CODE)
+            return mmap::INVALID_BLOB;
+
+        std::memcpy(this->heap.data() + offset, payload.data(), payload.size());
+        this->heap.count(offset + payload.size());
+
+        entry.inlined = 0;
+        entry.offset  = offset;
+    }
+
+    // Publish slot only after its payload is in place
+    this->index[id] = entry;
+    std::atomic_thread_fence(std::memory_order_release);
+    this->index.count(id + 1);
+
+    return id;
+}
+
+
+mmap::size_type
+mmap::blob_file::size() const noexcept
+{
+    return this->index.count();
+}
+
+mmap::size_type
+mmap::blob_file::heap_size() const noexcept
+{
+    return this->heap.count();
+}
+
+
+template <typename data_type>
+mmap::status_code
+mmap::blob_file::reserve
+(
+    ordered_file<data_type> &mapping,
+    const size_type          required
+) noexcept
+{
+    if (required <= mapping.size())
+        return mmap::GLOBAL_SUCCESS_CODE;
+
+    // Grow geometrically so appends stay amortized constant
+    const size_type capacity = std::max(required, 2 * mapping.size());
+    if (!mapping.remap(capacity))
+    {
+        util::log::record
+        (
+            "Unable to grow blob store mapping",
+            util::log::type::ERROR
+        );
+
+        return mmap::EXTERNAL_ERROR_CODE;
+    }
+
+    return mmap::GLOBAL_SUCCESS_CODE;
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "file/ordered_file.hpp"
+
+
+namespace mmap
+{
+
+using blob_id = std::uint64_t;
+
+constexpr blob_id   INVALID_BLOB       = static_cast<blob_id>(-1);
+constexpr size_type BLOB_INLINE_BYTES  = 24;
+
+// Index slot; short payloads live in the slot itself
+struct blob_entry
+{
+    std::uint32_t length;
+    std::uint32_t inlined;
+    union
+    {
+        std::uint64_t offset;
+        char          bytes[BLOB_INLINE_BYTES];
+    };
+};
+
+// Append-only store of variable-length payloads: an index file of
+// (offset, length) slots over a heap file of concatenated bytes
+class blob_file
+{
+private:
+    // Backing mappings; both self-describing so counts survive reopen
+    ordered_file<blob_entry> index;
+    ordered_file<char>       heap;
+
+    bool                     inline_flag = true;
+
+public:
+    blob_file
+    (
+        // Required parameters
+        const std::string &file_path,
+
+        // Advanced parameters
+        const size_type    index_capacity = 1024,
+        const size_type    heap_capacity  = 1 << 16,
+
+        // Layout flags
+        const bool         inline_flag    = true
+    );
+
+    virtual ~blob_file() noexcept = default;
+
+    // No copies permitted
+    blob_file(const blob_file &other)           = delete;
+    blob_file operator=(const blob_file &other) = delete;
+
+    status_code
+    virtual open() noexcept;
+    status_code
+    virtual flush() noexcept;
+    status_code
+    virtual close() noexcept;
+
+    // Views stay valid until the next append that grows a mapping
+    std::string_view
+    get
+    (
+        const blob_id id
+    ) const noexcept;
+    // Payloads over UINT32_MAX bytes are refused with INVALID_BLOB
+    blob_id
+    append
+    (
+        const std::string_view payload
+    ) noexcept;
+
+    size_type
+    size() const noexcept;
+    size_type
+    heap_size() const noexcept;
+
+protected:
+    template <typename data_type>
+    status_code
+    reserve
+    (
+        ordered_file<data_type> &mapping,
+        const size_type          required
+    ) noexcept;
+};
+
+} // mmap namespace
@@ -0,0 +1,302 @@
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <string>
+
+#include <util/record.hpp>
+
+#include "bloom_filter.hpp"
+
+
+namespace
+{
+
+// Metadata block word layout
+constexpr mmap::size_type META_BLOCKS   = 0;
+constexpr mmap::size_type META_PROBES   = 1;
+constexpr mmap::size_type META_INSERTED = 2;
+
+std::atomic<std::uint64_t> &
+atomic_word
+(
+    mmap::bloom_block &block,
+    const mmap::size_type index
+) noexcept
+{
+    return *reinterpret_cast<std::atomic<std::uint64_t> *>(&block.words[index]);
+}
+
+// Finalizer from splitmix64; decorrelates probe bits from block choice
+std::uint64_t
+mix
+(
+    std::uint64_t value
+) noexcept
+{
+    value ^= value >> 30;
+    value *= 0xbf58476d1ce4e5b9;
+    value ^= value >> 27;
+    value *= 0x94d049bb133111eb;
+    value ^= value >> 31;
+
+    return value;
+}
+
+// Per-word masks of the probe bits of hash within its block
+void
+probe_masks
+(
+    const std::uint64_t   hash,
+    const mmap::size_type probe_count,
+    std::uint64_t        (&masks)[mmap::BLOOM_BLOCK_WORDS]
+) noexcept
+{
+    const std::uint64_t mixed = mix(hash);
+    const std::uint32_t first = static_cast<std::uint32_t>(mixed);
+    const std::uint32_t step  = static_cast<std::uint32_t>(mixed >> 32) | 1;
+
+    std::memset(masks, 0, sizeof(masks));
+    for (mmap::size_type probe = 0; probe < probe_count; ++probe)
+    {
+        const std::uint32_t bit = (first + probe * step) % mmap::BLOOM_BLOCK_BITS;
+        masks[bit / 64] |= std::uint64_t(1) << (bit % 64);
+    }
+}
+
+} // anonymous namespace
+
+
+mmap::bloom_filter::bloom_filter
+(
+    // Required parameters
+    const std::string &file_path,
+    const size_type    block_count,
+
+    // Advanced parameters
+    const size_type    probe_count
+):  blocks
+    (
+        file_path,
+        std::max<size_type>(1, block_count) + 1,
+        0,
+        nullptr,
+        O_RDWR | O_CREAT,
+        LOCK_SH,
+        PROT_READ | PROT_WRITE,
+        MAP_SHARED,
+        MS_ASYNC,
+        MREMAP_MAYMOVE,
+        mmap::NO_ALLOCATE,
+        true
+    )
+{
+    // metadata
+    this->block_count = std::max<size_type>(1, block_count);
+    this->probe_count = std::clamp<size_type>(probe_count, 1, mmap::BLOOM_BLOCK_BITS);
+}
+
+
+mmap::status_code
+mmap::bloom_filter::open() noexcept
+{
+    if (!this->blocks.open())
+    {
+        util::log::record
+        (
+            "Unable to open bloom filter",
+            util::log::type::ERROR
+        );
+
+        return mmap::EXTERNAL_ERROR_CODE;
+    }
+
+    // Fresh filter records its parameters
+    bloom_block &meta = this->blocks[0];
+    if (!this->blocks.count())
+    {
+        meta.words[META_BLOCKS]   = this->block_count;
+        meta.words[META_PROBES]   = this->probe_count;
+        meta.words[META_INSERTED] = 0;
+        this->blocks.count(this->block_count + 1);
+
+        return mmap::GLOBAL_SUCCESS_CODE;
+    }
+
+    // Existing filter must probe identically
+    if (meta.words[META_BLOCKS] != this->block_count || meta.words[META_PROBES] != this->probe_count)
+    {
+        util::log::record
+        (
+            "Bloom filter file was created with different parameters",
+            util::log::type::ERROR
+        );
+
+        this->blocks.close();
+        return mmap::EXTERNAL_ERROR_CODE;
+    }
+
+    return mmap::GLOBAL_SUCCESS_CODE;
+}
+
+mmap::status_code
+mmap::bloom_filter::flush() noexcept
+{
+    return this->blocks.flush();
+}
+
+mmap::status_code
+mmap::bloom_filter::close() noexcept
+{
+    return this->blocks.close();
+}
+
+
+bool
+mmap::bloom_filter::insert
+(
+    const std::uint64_t hash
+) noexcept
+{
+    std::uint64_t masks[mmap::BLOOM_BLOCK_WORDS];
+    probe_masks(hash, this->probe_count, masks);
+
+    // High bits pick the block without a division
+    const size_type index = static_cast<size_type>
+    (
+        (static_cast<unsigned __int128>(hash) * this->block_count) >> 64
+    ) + 1;
+    bloom_block &block = this->blocks[index];
+
+    bool present = true;
+    for (size_type word = 0; word < mmap::BLOOM_BLOCK_WORDS; ++word)
+    {
+        if (!masks[word])
+            continue;
+
+        const std::uint64_t previous = atomic_word(block, word)
+            .fetch_or(masks[word], std::memory_order_relaxed);
+        present &= (previous & masks[word]) == masks[word];
+    }
+
+    if (!present)
+        atomic_word(this->blocks[0], META_INSERTED).fetch_add(1, std::memory_order_relaxed);
+
+    return present;
+}
+
+bool
+mmap::bloom_filter::insert
+(
+    const std::string_view key
+) noexcept
+{
+    return this->insert(mmap::bloom_filter::hash(key));
+}
+
+bool
+mmap::bloom_filter::contains
+(
+    const std::uint64_t hash
+) const noexcept
+{
+    std::uint64_t masks[mmap::BLOOM_BLOCK_WORDS];
+    probe_masks(hash, this->probe_count, masks);
+
+    const size_type index = static_cast<size_type>
+    (
+        (static_cast<unsigned __int128>(hash) * this->block_count) >> 64
+    ) + 1;
+    bloom_block &block = this->blocks[index];
+
+    for (size_type word = 0; word < mmap::BLOOM_BLOCK_WORDS; ++word)
+    {
+        const std::uint64_t value = atomic_word(block, word).load(std::memory_order_relaxed);
+        if ((value & masks[word]) != masks[word])
+            return false;
+    }
+
+    return true;
+}
+
+bool
+mmap::bloom_filter::contains
+(
+    const std::string_view key
+) const noexcept
+{
+    return this->contains(mmap::bloom_filter::hash(key));
+}
+
+
+mmap::size_type
+mmap::bloom_filter::size() const noexcept
+{
+    return this->block_count;
+}
+
+mmap::size_type
+mmap::bloom_filter::inserted() const noexcept
+{
+    return atomic_word(this->blocks[0], META_INSERTED).load(std::memory_order_relaxed);
+}
+
+mmap::size_type
+mmap::bloom_filter::blocks_for
+(
+    const size_type expected_keys,
+    const double    false_positive_rate
+) noexcept
+{
+    // Classic optimum m = -n ln p / (ln 2)^2, rounded up to whole blocks;
+    // blocking costs a little accuracy, so realized rates run slightly high
+    const double bits = -static_cast<double>(expected_keys) * std::log(false_positive_rate)
+        / (std::log(2.0) * std::log(2.0));
+
+    return std::max<size_type>(1, static_cast<size_type>(std::ceil(bits / mmap::BLOOM_BLOCK_BITS)));
+}
+
+std::uint64_t
+mmap::bloom_filter::hash
+(
+    const std::string_view key
+) noexcept
+{
+    // MurmurHash64A
+    constexpr std::uint64_t multiplier = 0xc6a4a7935bd1e995;
+    constexpr int           shift      = 47;
+
+    const std::uint8_t *bytes  = reinterpret_cast<const std::uint8_t *>(key.data());
+    size_type           length = key.size();
+    std::uint64_t       value  = 0x8445d61a4e774912 ^ (length * multiplier);
+
+    while (length >= 8)
+    {
+        std::uint64_t word;
+        std::memcpy(&word, bytes, 8);
+
+        word  *= multiplier;
+        word  ^= word >> shift;
+        word  *= multiplier;
+        value ^= word;
+        value *= multiplier;
+
+        bytes  += 8;
+        length -= 8;
+    }
+
+    if (length)
+    {
+        std::uint64_t tail = 0;
+        std::memcpy(&tail, bytes, length);
+
+        value ^= tail;
+        value *= multiplier;
+    }
+
+    value ^= value >> shift;
+    value *= multiplier;
+    value ^= value >> shift;
+
+    return value;
+}
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "file/ordered_file.hpp"
+
+
+namespace mmap
+{
+
+constexpr size_type BLOOM_BLOCK_WORDS = 8;
+constexpr size_type BLOOM_BLOCK_BITS  = BLOOM_BLOCK_WORDS * 64;
+
+// One cache line of filter bits; every probe of a key lands in one block
+struct alignas(64) bloom_block
+{
+    std::uint64_t words[BLOOM_BLOCK_WORDS];
+};
+
+// Blocked Bloom filter persisted in a described file; the first block holds
+// the filter parameters so a reopened filter probes identically
+class bloom_filter
+{
+private:
+    // Backing mapping; block zero is metadata
+    ordered_file<bloom_block> blocks;
+
+    // User provided filter metadata
+    size_type                 block_count;
+    size_type                 probe_count;
+
+public:
+    bloom_filter
+    (
+        // Required parameters
+        const std::string &file_path,
+        const size_type    block_count,
+
+        // Advanced parameters
+        const size_type    probe_count = 8
+    );
+
+    virtual ~bloom_filter() noexcept = default;
+
+    // No copies permitted
+    bloom_filter(const bloom_filter &other)           = delete;
+    bloom_filter operator=(const bloom_filter &other) = delete;
+
+    status_code
+    virtual open() noexcept;
+    status_code
+    virtual flush() noexcept;
+    status_code
+    virtual close() noexcept;
+
+    // Return whether key may already have been present; safe concurrently
+    bool
+    insert
+    (
+        const std::uint64_t hash
+    ) noexcept;
+    bool
+    insert
+    (
+        const std::string_view key
+    ) noexcept;
+
+    bool
+    contains
+    (
+        const std::uint64_t hash
+    ) const noexcept;
+    bool
+    contains
+    (
+        const std::string_view key
+    ) const noexcept;
+
+    size_type
+    size() const noexcept;
+
+    // Approximate keys inserted, counted on first insertion only
+    size_type
+    inserted() const noexcept;
+
+    // Size a filter for expected keys at a target false positive rate
+    static size_type
+    blocks_for
+    (
+        const size_type expected_keys,
+        const double    false_positive_rate
+    ) noexcept;
+
+    static std::uint64_t
+    hash
+    (
+        const std::string_view key
+    ) noexcept;
+};
+
+} // mmap namespace
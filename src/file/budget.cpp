@@ -0,0 +1,536 @@
+#include <algorithm>
+#include <exception>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <util/record.hpp>
+
+#include "budget.hpp"
+
+
+// Advice values predate some libc headers
+#ifndef MADV_COLD
+#define MADV_COLD 20
+#endif
+
+#ifndef MADV_PAGEOUT
+#define MADV_PAGEOUT 21
+#endif
+
+
+namespace
+{
+
+constexpr char PRESSURE_PATH[] = "/proc/pressure/memory";
+constexpr char PAGEMAP_PATH[]  = "/proc/self/pagemap";
+
+constexpr std::uint64_t PAGEMAP_PRESENT = std::uint64_t(1) << 63;
+
+// Page table entries read per call, whatever the page size
+constexpr mmap::size_type PAGEMAP_CHUNK = 512;
+
+// Ranges only advised cold once residency passes this share of the low watermark
+constexpr double COOL_FRACTION = 0.9;
+
+// One resident range of a tracked mapping, ordered least valuable first
+struct candidate
+{
+    std::uint8_t    *address;
+    mmap::size_type  length;
+    mmap::size_type  resident;
+    mmap::residency  priority;
+    bool             clean;
+    bool             discardable;
+    std::uint64_t    last_access;
+};
+
+// Bytes of range mapped into this process's page tables
+mmap::size_type
+present_bytes
+(
+    const std::uint8_t          *address,
+    const mmap::size_type        length,
+    const sys::file::descriptor  pagemap
+) noexcept
+{
+    const mmap::size_type page_size  = sys::memory::page_size;
+    const mmap::size_type first_page = reinterpret_cast<mmap::size_type>(address) / page_size;
+    const mmap::size_type page_count = (length + page_size - 1) / page_size;
+
+    if (pagemap == mmap::INTERNAL_ERROR_CODE)
+        return 0;
+
+    std::uint64_t   entries[PAGEMAP_CHUNK];
+    mmap::size_type count = 0;
+    for (mmap::size_type done = 0; done < page_count; done += PAGEMAP_CHUNK)
+    {
+        const mmap::size_type chunk = std::min(PAGEMAP_CHUNK, page_count - done);
+
+        ssize_t read_status = sys::file::read
+        (
+            pagemap,
+            entries,
+            chunk * sizeof(std::uint64_t),
+            (first_page + done) * sizeof(std::uint64_t)
+        );
+        if (read_status != static_cast<ssize_t>(chunk * sizeof(std::uint64_t)))
+            return 0;
+
+        for (mmap::size_type page = 0; page < chunk; ++page)
+            count += (entries[page] & PAGEMAP_PRESENT) != 0;
+    }
+
+    return count * page_size;
+}
+
+} // anonymous namespace
+
+
+mmap::memory_budget::memory_budget
+(
+    // Required parameters
+    const size_type budget_bytes,
+
+    // Advanced parameters
+    const double    pressure_threshold,
+    const double    low_watermark
+)
+{
+    // metadata
+    this->budget_bytes       = budget_bytes;
+    this->pressure_threshold = pressure_threshold;
+    this->low_watermark      = std::clamp(low_watermark, 0.0, 1.0);
+}
+
+mmap::memory_budget::~memory_budget() noexcept
+{
+    this->stop();
+}
+
+mmap::memory_budget &
+mmap::memory_budget::global() noexcept
+{
+    // Unlimited until configured
+    static memory_budget registry(static_cast<size_type>(-1));
+
+    return registry;
+}
+
+
+mmap::budget_id
+mmap::memory_budget::track
+(
+    file            &mapping,
+    const residency  priority
+) noexcept
+{
+    // Check if mapped
+    if (!mapping.address())
+    {
+        util::log::record
+        (
+            "Memory is not yet mapped",
+            util::log::type::ERROR
+        );
+
+        return mmap::INVALID_BUDGET_ID;
+    }
+
+    const size_type range_count = (mapping.capacity() + mmap::BUDGET_RANGE_BYTES - 1)
+        / mmap::BUDGET_RANGE_BYTES;
+
+    try
+    {
+        std::unique_ptr<entry> tracked = std::make_unique<entry>();
+        tracked->mapping     = &mapping;
+        tracked->priority    = priority;
+        tracked->range_count = range_count;
+        tracked->last_access = std::make_unique<std::atomic<std::uint64_t>[]>(range_count);
+
+        // New mappings start as recently used
+        const std::uint64_t now = this->clock.fetch_add(1, std::memory_order_relaxed);
+        for (size_type range = 0; range < range_count; ++range)
+            tracked->last_access[range].store(now, std::memory_order_relaxed);
+
+        const budget_id id = reinterpret_cast<budget_id>(tracked.get());
+
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->entries.emplace(id, std::move(tracked));
+
+        return id;
+    }
+
+    catch (const std::exception &exception)
+    {
+        util::log::record
+        (
+            "Unable to track mapping in memory budget",
+            util::log::type::ERROR
+        );
+
+        return mmap::INVALID_BUDGET_ID;
+    }
+}
+
+mmap::status_code
+mmap::memory_budget::untrack
+(
+    const budget_id id
+) noexcept
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    if (!this->entries.erase(id))
+        return mmap::EXTERNAL_ERROR_CODE;
+
+    return mmap::GLOBAL_SUCCESS_CODE;
+}
+
+mmap::status_code
+mmap::memory_budget::prioritize
+(
+    const budget_id  id,
+    const residency  priority
+) noexcept
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    auto found = this->entries.find(id);
+    if (found == this->entries.end())
+        return mmap::EXTERNAL_ERROR_CODE;
+
+    found->second->priority = priority;
+
+    return mmap::GLOBAL_SUCCESS_CODE;
+}
+
+void
+mmap::memory_budget::touch
+(
+    const budget_id id,
+    const size_type offset,
+    const size_type length
+) noexcept
+{
+    if (id == mmap::INVALID_BUDGET_ID || !length)
+        return;
+
+    // Entry stays put while tracked; only atomics are written
+    const entry        &tracked = *reinterpret_cast<const entry *>(id);
+    const std::uint64_t now     = this->clock.fetch_add(1, std::memory_order_relaxed);
+
+    const size_type first = offset / mmap::BUDGET_RANGE_BYTES;
+    const size_type last  = std::min
+    (
+        (offset + length - 1) / mmap::BUDGET_RANGE_BYTES + 1,
+        tracked.range_count
+    );
+    for (size_type range = first; range < last; ++range)
+        tracked.last_access[range].store(now, std::memory_order_relaxed);
+}
+
+
+mmap::size_type
+mmap::memory_budget::resident() const noexcept
+{
+    sys::file::descriptor pagemap = sys::file::open(PAGEMAP_PATH, O_RDONLY | O_CLOEXEC);
+
+    std::lock_guard<std::mutex> lock(this->mutex);
+
+    size_type total = 0;
+    for (const auto &[id, tracked]: this->entries)
+    {
+        for (size_type range = 0; range < tracked->range_count; ++range)
+            total += this->range_resident(*tracked, range, pagemap);
+    }
+
+    if (pagemap != mmap::INTERNAL_ERROR_CODE)
+        sys::file::close(pagemap);
+
+    return total;
+}
+
+mmap::size_type
+mmap::memory_budget::budget() const noexcept
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+
+    return this->budget_bytes;
+}
+
+void
+mmap::memory_budget::budget
+(
+    const size_type budget_bytes
+) noexcept
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->budget_bytes = budget_bytes;
+}
+
+
+double
+mmap::memory_budget::pressure() noexcept
+{
+    // Line format: some avg10=0.00 avg60=0.00 avg300=0.00 total=0
+    std::ifstream stream(PRESSURE_PATH);
+    std::string   line;
+    while (std::getline(stream, line))
+    {
+        if (line.rfind("some ", 0) != 0)
+            continue;
+
+        const std::string::size_type field = line.find("avg10=");
+        if (field == std::string::npos)
+            return -1;
+
+        try
+        {
+            return std::stod(line.substr(field + 6));
+        }
+
+        catch (const std::exception &exception)
+        {
+            return -1;
+        }
+    }
+
+    return -1;
+}
+
+mmap::budget_report
+mmap::memory_budget::enforce() noexcept
+{
+    budget_report report;
+    report.pressure = mmap::memory_budget::pressure();
+
+    // Residency is read from page tables, so it reflects what advice removed
+    sys::file::descriptor pagemap = sys::file::open(PAGEMAP_PATH, O_RDONLY | O_CLOEXEC);
+    if (pagemap == mmap::INTERNAL_ERROR_CODE)
+    {
+        util::log::record
+        (
+            "Unable to open process page map",
+            util::log::type::ERROR
+        );
+
+        return report;
+    }
+
+    std::lock_guard<std::mutex> lock(this->mutex);
+
+    // Measure residency per range; pinned ranges count but are never candidates
+    std::vector<candidate> candidates;
+    try
+    {
+        for (const auto &[id, tracked]: this->entries)
+        {
+            const sys::memory::flag_code protocol = tracked->mapping->protocol();
+            const sys::memory::flag_code mapping  = tracked->mapping->mapping();
+
+            for (size_type range = 0; range < tracked->range_count; ++range)
+            {
+                const size_type resident = this->range_resident(*tracked, range, pagemap);
+                report.resident_bytes += resident;
+
+                if (!resident || tracked->priority == residency::PINNED)
+                    continue;
+
+                const size_type start = range * mmap::BUDGET_RANGE_BYTES;
+                candidates.push_back
+                ({
+                    static_cast<std::uint8_t *>(tracked->mapping->address()) + start,
+                    range_length(*tracked, range),
+                    resident,
+                    tracked->priority,
+                    !(protocol & PROT_WRITE),
+                    (mapping & MAP_SHARED) || !(protocol & PROT_WRITE),
+                    tracked->last_access[range].load(std::memory_order_relaxed)
+                });
+            }
+        }
+    }
+
+    catch (const std::exception &exception)
+    {
+        util::log::record
+        (
+            "Unable to collect memory budget candidates",
+            util::log::type::ERROR
+        );
+
+        sys::file::close(pagemap);
+        return report;
+    }
+
+    const size_type target   = static_cast<size_type>(this->budget_bytes * this->low_watermark);
+    const bool      pressure = this->pressure_threshold > 0
+        && report.pressure >= this->pressure_threshold;
+    const bool      evict    = report.resident_bytes > this->budget_bytes || pressure;
+    const bool      cool     = report.resident_bytes > target * COOL_FRACTION;
+    if (!evict && !cool)
+    {
+        sys::file::close(pagemap);
+        return report;
+    }
+
+    // Lowest priority, then clean before dirty, then least recently used
+    std::sort
+    (
+        candidates.begin(),
+        candidates.end(),
+        [](const candidate &left, const candidate &right)
+        {
+            if (left.priority != right.priority)
+                return left.priority < right.priority;
+            if (left.clean != right.clean)
+                return left.clean;
+
+            return left.last_access < right.last_access;
+        }
+    );
+
+    size_type remaining = report.resident_bytes;
+    for (const candidate &range: candidates)
+    {
+        if (evict && remaining > target)
+        {
+            // Shared and read-only pages survive in page cache; private
+            // writable pages must be written to swap rather than dropped
+            const sys::memory::flag_code advice = range.discardable ? MADV_DONTNEED : MADV_PAGEOUT;
+            if (sys::memory::advise(range.address, range.length, advice) == mmap::INTERNAL_ERROR_CODE)
+                continue;
+
+            // Page out may leave pages in place, e.g. without swap
+            const size_type evicted = range.resident
+                - std::min(range.resident, present_bytes(range.address, range.length, pagemap));
+            report.evicted_bytes += evicted;
+            remaining            -= evicted;
+        }
+
+        else if (remaining - report.cooled_bytes > target * COOL_FRACTION)
+        {
+            // Kernel reclaims these first without dropping them now
+            if (sys::memory::advise(range.address, range.length, MADV_COLD) == mmap::INTERNAL_ERROR_CODE)
+                continue;
+
+            report.cooled_bytes += range.resident;
+        }
+
+        else
+            break;
+    }
+    sys::file::close(pagemap);
+
+    if (report.evicted_bytes)
+    {
+        util::log::record
+        (
+            "Memory budget evicted " + std::to_string(report.evicted_bytes) + " bytes",
+            util::log::type::FLAG
+        );
+    }
+
+    return report;
+}
+
+
+mmap::status_code
+mmap::memory_budget::start
+(
+    const std::chrono::milliseconds interval
+) noexcept
+{
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        if (this->worker.joinable())
+        {
+            util::log::record
+            (
+                "Memory budget enforcement is already running",
+                util::log::type::ERROR
+            );
+
+            return mmap::EXTERNAL_ERROR_CODE;
+        }
+        this->stopping = false;
+    }
+
+    try
+    {
+        this->worker = std::thread
+        (
+            [this, interval]()
+            {
+                std::unique_lock<std::mutex> lock(this->mutex);
+                while (!this->wake.wait_for(lock, interval, [this]() { return this->stopping; }))
+                {
+                    lock.unlock();
+                    this->enforce();
+                    lock.lock();
+                }
+            }
+        );
+    }
+
+    catch (const std::exception &exception)
+    {
+        util::log::record
+        (
+            "Unable to start memory budget enforcement",
+            util::log::type::ERROR
+        );
+
+        return mmap::EXTERNAL_ERROR_CODE;
+    }
+
+    return mmap::GLOBAL_SUCCESS_CODE;
+}
+
+void
+mmap::memory_budget::stop() noexcept
+{
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->stopping = true;
+    }
+    this->wake.notify_all();
+
+    if (this->worker.joinable())
+        this->worker.join();
+}
+
+
+mmap::size_type
+mmap::memory_budget::range_resident
+(
+    const entry                 &tracked,
+    const size_type              range,
+    const sys::file::descriptor  pagemap
+) const noexcept
+{
+    const size_type start = range * mmap::BUDGET_RANGE_BYTES;
+
+    return present_bytes
+    (
+        static_cast<std::uint8_t *>(tracked.mapping->address()) + start,
+        range_length(tracked, range),
+        pagemap
+    );
+}
+
+mmap::size_type
+mmap::memory_budget::range_length
+(
+    const entry     &tracked,
+    const size_type  range
+) noexcept
+{
+    // Ranges are fixed at track; a mapping shrunk since leaves them empty
+    const size_type start    = range * mmap::BUDGET_RANGE_BYTES;
+    const size_type capacity = tracked.mapping->capacity();
+    if (start >= capacity)
+        return 0;
+
+    return std::min(mmap::BUDGET_RANGE_BYTES, capacity - start);
+}
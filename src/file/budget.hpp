@@ -0,0 +1,166 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "file/file.hpp"
+
+
+namespace mmap
+{
+
+using budget_id = std::uint64_t;
+
+constexpr budget_id INVALID_BUDGET_ID  = 0;
+constexpr size_type BUDGET_RANGE_BYTES = 2 << 20;
+
+// Eviction order; pinned mappings are never advised
+enum class residency: std::uint8_t
+{
+    COLD   = 0x00,
+    NORMAL = 0x01,
+    HOT    = 0x02,
+    PINNED = 0x03
+};
+
+// Outcome of one enforcement pass
+struct budget_report
+{
+    size_type resident_bytes = 0;
+    size_type evicted_bytes  = 0;
+    size_type cooled_bytes   = 0;
+    double    pressure       = 0;
+};
+
+// Registry of live mappings holding their combined residency under a byte
+// budget; least valuable ranges are advised out first
+class memory_budget
+{
+private:
+    struct entry
+    {
+        file                                          *mapping;
+        residency                                      priority;
+        size_type                                      range_count;
+        std::unique_ptr<std::atomic<std::uint64_t>[]>  last_access;
+    };
+
+    // User provided budget metadata
+    size_type   budget_bytes;
+    double      pressure_threshold;
+    double      low_watermark;
+
+    // Registered mappings; an id is the address of its entry, so touch
+    // reaches the entry without the registry lock
+    std::map<budget_id, std::unique_ptr<entry>>  entries;
+    std::atomic<std::uint64_t>                   clock{1};
+    mutable std::mutex                           mutex;
+
+    // Background enforcement
+    std::thread                                  worker;
+    std::condition_variable                      wake;
+    bool                                         stopping = false;
+
+public:
+    memory_budget
+    (
+        // Required parameters
+        const size_type budget_bytes,
+
+        // Advanced parameters
+        const double    pressure_threshold = 10.0,
+        const double    low_watermark      = 0.75
+    );
+
+    virtual ~memory_budget() noexcept;
+
+    // No copies permitted
+    memory_budget(const memory_budget &other)           = delete;
+    memory_budget operator=(const memory_budget &other) = delete;
+
+    // Process wide registry
+    static memory_budget &
+    global() noexcept;
+
+    // Mapping must stay open, at the same address and capacity, until it is
+    // removed; untrack before a remap and track again after
+    budget_id
+    track
+    (
+        file            &mapping,
+        const residency  priority = residency::NORMAL
+    ) noexcept;
+    status_code
+    untrack
+    (
+        const budget_id id
+    ) noexcept;
+    status_code
+    prioritize
+    (
+        const budget_id  id,
+        const residency  priority
+    ) noexcept;
+
+    // Last access hint over a byte range of a tracked mapping; lock free,
+    // so id must stay tracked until touch returns
+    void
+    touch
+    (
+        const budget_id id,
+        const size_type offset,
+        const size_type length
+    ) noexcept;
+
+    size_type
+    resident() const noexcept;
+    size_type
+    budget() const noexcept;
+    void
+    budget
+    (
+        const size_type budget_bytes
+    ) noexcept;
+
+    // Memory some avg10 from pressure stall information; negative if absent
+    static double
+    pressure() noexcept;
+
+    // Cool ranges near the budget, evict down to the low watermark above it
+    // or when pressure crosses its threshold
+    budget_report
+    enforce() noexcept;
+
+    status_code
+    start
+    (
+        const std::chrono::milliseconds interval
+    ) noexcept;
+    void
+    stop() noexcept;
+
+protected:
+    // Pages of range present in this process's page tables
+    size_type
+    range_resident
+    (
+        const entry                 &tracked,
+        const size_type              range,
+        const sys::file::descriptor  pagemap
+    ) const noexcept;
+    // Bytes of range inside the mapping's current capacity
+    static size_type
+    range_length
+    (
+        const entry     &tracked,
+        const size_type  range
+    ) noexcept;
+};
+
+} // mmap namespace
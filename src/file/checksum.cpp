@@ -0,0 +1,601 @@
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <exception>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+#if defined(__x86_64__)
+#include <nmmintrin.h>
+#endif
+
+#include <util/pool.hpp>
+#include <util/record.hpp>
+
+#include "checksum.hpp"
+
+
+namespace
+{
+
+constexpr std::uint32_t CRC32C_POLYNOMIAL = 0x82f63b78;  // reflected Castagnoli
+
+constexpr mmap::size_type DIRTY_WORD_BITS = 64;
+
+// Slicing-by-8 tables for the portable path
+constexpr std::array<std::array<std::uint32_t, 256>, 8>
+crc32c_tables() noexcept
+{
+    std::array<std::array<std::uint32_t, 256>, 8> tables = {};
+    for (std::uint32_t byte = 0; byte < 256; ++byte)
+    {
+        std::uint32_t crc = byte;
+        for (int bit = 0; bit < 8; ++bit)
+            crc = (crc >> 1) ^ (CRC32C_POLYNOMIAL & (0 - (crc & 1)));
+        tables[0][byte] = crc;
+    }
+
+    for (std::size_t slice = 1; slice < 8; ++slice)
+    {
+        for (std::size_t byte = 0; byte < 256; ++byte)
+        {
+            const std::uint32_t previous = tables[slice - 1][byte];
+            tables[slice][byte] = (previous >> 8) ^ tables[0][previous & 0xff];
+        }
+    }
+
+    return tables;
+}
+
+constexpr std::array<std::array<std::uint32_t, 256>, 8> CRC32C_TABLES = crc32c_tables();
+
+std::uint32_t
+crc32c_software
+(
+    const std::uint8_t *bytes,
+    mmap::size_type     length,
+    std::uint32_t       crc
+) noexcept
+{
+    while (length >= 8)
+    {
+        std::uint32_t low;
+        std::uint32_t high;
+        std::memcpy(&low, bytes, 4);
+        std::memcpy(&high, bytes + 4, 4);
+        low ^= crc;
+
+        crc = CRC32C_TABLES[7][low & 0xff]
+            ^ CRC32C_TABLES[6][(low >> 8) & 0xff]
+            ^ CRC32C_TABLES[5][(low >> 16) & 0xff]
+            ^ CRC32C_TABLES[4][low >> 24]
+            ^ CRC32C_TABLES[3][high & 0xff]
+            ^ CRC32C_TABLES[2][(high >> 8) & 0xff]
+            ^ CRC32C_TABLES[1][(high >> 16) & 0xff]
+            ^ CRC32C_TABLES[0][high >> 24];
+
+        bytes  += 8;
+        length -= 8;
+    }
+
+    while (length--)
+        crc = (crc >> 8) ^ CRC32C_TABLES[0][(crc ^ *bytes++) & 0xff];
+
+    return crc;
+}
+
+#if defined(__x86_64__)
+__attribute__((target("sse4.2")))
+std::uint32_t
+crc32c_hardware
+(
+    const std::uint8_t *bytes,
+    mmap::size_type     length,
+    std::uint32_t       crc
+) noexcept
+{
+    std::uint64_t wide = crc;
+    while (length >= 8)
+    {
+        std::uint64_t word;
+        std::memcpy(&word, bytes, 8);
+        wide = _mm_crc32_u64(wide, word);
+
+        bytes  += 8;
+        length -= 8;
+    }
+
+    crc = static_cast<std::uint32_t>(wide);
+    while (length--)
+        crc = _mm_crc32_u8(crc, *bytes++);
+
+    return crc;
+}
+
+const bool CRC32C_HARDWARE = __builtin_cpu_supports("sse4.2");
+#endif
+
+} // anonymous namespace
+
+
+std::uint32_t
+mmap::checksum::crc32c
+(
+    const void          *data,
+    const size_type      length,
+    const std::uint32_t  seed
+) noexcept
+{
+    const std::uint8_t *bytes = static_cast<const std::uint8_t *>(data);
+
+#if defined(__x86_64__)
+    if (CRC32C_HARDWARE)
+        return ~crc32c_hardware(bytes, length, ~seed);
+#endif
+
+    return ~crc32c_software(bytes, length, ~seed);
+}
+
+
+mmap::checked_file::checked_file
+(
+    // Required parameters
+    file              &origin,
+    const std::string &checksum_path,
+
+    // Advanced parameters
+    const size_type    block_size
+):  origin(origin)
+{
+    // Validate origin mapping
+    if (!origin.address())
+    {
+        util::log::record
+        (
+            "Checksum origin is not mapped: "
+            "open the file before attaching checksums",
+            util::log::type::ABORT
+        );
+
+        throw std::runtime_error("Provided checksum origin is not mapped");
+    }
+
+    // Slot stores block size in 32 bits
+    if (!block_size || block_size > UINT32_MAX)
+    {
+        util::log::record
+        (
+            "Checksum block size must be non-zero and fit in 32 bits",
+            util::log::type::ABORT
+        );
+
+        throw std::runtime_error("Provided checksum block size is invalid");
+    }
+
+    // metadata
+    this->checksum_path = checksum_path;
+    this->block_size    = block_size;
+}
+
+mmap::checked_file::~checked_file() noexcept
+{
+    if (this->checksums)
+        this->close();
+}
+
+
+mmap::status_code
+mmap::checked_file::open
+(
+    const size_type thread_count
+) noexcept
+{
+    // Check if opened
+    if (this->checksums)
+    {
+        util::log::record
+        (
+            "Checksums are already open",
+            util::log::type::ERROR
+        );
+
+        return mmap::EXTERNAL_ERROR_CODE;
+    }
+
+    this->checked_capacity = this->origin.capacity();
+    this->block_count      = (this->checked_capacity + this->block_size - 1) / this->block_size;
+    const size_type dirty_words = (this->block_count + DIRTY_WORD_BITS - 1) / DIRTY_WORD_BITS;
+
+    // Map side file and dirty bitmap
+    try
+    {
+        this->checksums = std::make_unique<ordered_file<block_checksum>>
+        (
+            this->checksum_path,
+            std::max<size_type>(1, this->block_count),
+            0,
+            nullptr,
+            O_RDWR | O_CREAT,
+            LOCK_SH,
+            PROT_READ | PROT_WRITE,
+            MAP_SHARED,
+            MS_SYNC,
+            MREMAP_MAYMOVE,
+            mmap::NO_ALLOCATE,
+            true
+        );
+        this->dirty = std::make_unique<std::atomic<std::uint64_t>[]>(dirty_words);
+    }
+
+    catch (const std::exception &exception)
+    {
+        this->checksums.reset();
+        return mmap::EXTERNAL_ERROR_CODE;
+    }
+
+    for (size_type word = 0; word < dirty_words; ++word)
+        this->dirty[word].store(0, std::memory_order_relaxed);
+
+    if (!this->checksums->open())
+    {
+        util::log::record
+        (
+            "Unable to open checksum side file",
+            util::log::type::ERROR
+        );
+
+        this->checksums.reset();
+        return mmap::EXTERNAL_ERROR_CODE;
+    }
+
+    // Fresh side file describes nothing yet
+    if (this->checksums->count() != this->block_count)
+    {
+        if (this->checksums->count())
+        {
+            util::log::record
+            (
+                "Checksum side file does not match file size; rehashing",
+                util::log::type::FLAG
+            );
+        }
+
+        return this->rehash(thread_count);
+    }
+
+    // Existing side file must use the same blocking
+    if (this->block_count && (*this->checksums)[0].block_size != this->block_size)
+    {
+        util::log::record
+        (
+            "Checksum side file uses a different block size",
+            util::log::type::ERROR
+        );
+
+        this->checksums->close();
+        this->checksums.reset();
+        return mmap::EXTERNAL_ERROR_CODE;
+    }
+
+    return mmap::GLOBAL_SUCCESS_CODE;
+}
+
+mmap::status_code
+mmap::checked_file::flush() noexcept
+{
+    // Check if opened
+    if (!this->checksums)
+    {
+        util::log::record
+        (
+            "Checksums are not yet open",
+            util::log::type::ERROR
+        );
+
+        return mmap::EXTERNAL_ERROR_CODE;
+    }
+
+    if (this->resized())
+        return mmap::EXTERNAL_ERROR_CODE;
+
+    // Rehash only blocks written since last flush
+    const size_type dirty_words = (this->block_count + DIRTY_WORD_BITS - 1) / DIRTY_WORD_BITS;
+    for (size_type word = 0; word < dirty_words; ++word)
+    {
+        std::uint64_t bits = this->dirty[word].exchange(0, std::memory_order_acq_rel);
+        while (bits)
+        {
+            const size_type block = word * DIRTY_WORD_BITS + __builtin_ctzll(bits);
+            (*this->checksums)[block] =
+            {
+                this->block_crc(block),
+                static_cast<std::uint32_t>(this->block_size)
+            };
+
+            bits &= bits - 1;
+        }
+    }
+
+    // Data reaches file before checksums that describe it
+    if (this->origin.flush() == mmap::EXTERNAL_ERROR_CODE)
+        return mmap::EXTERNAL_ERROR_CODE;
+
+    return this->checksums->flush();
+}
+
+mmap::status_code
+mmap::checked_file::close() noexcept
+{
+    // Check if opened
+    if (!this->checksums)
+    {
+        util::log::record
+        (
+            "Checksums are not yet open",
+            util::log::type::ERROR
+        );
+
+        return mmap::EXTERNAL_ERROR_CODE;
+    }
+
+    mmap::status_code flush_status = this->flush();
+    mmap::status_code close_status = this->checksums->close();
+
+    this->checksums.reset();
+    this->dirty.reset();
+    this->block_count      = 0;
+    this->checked_capacity = 0;
+
+    if (flush_status == mmap::EXTERNAL_ERROR_CODE || close_status == mmap::EXTERNAL_ERROR_CODE)
+        return mmap::EXTERNAL_ERROR_CODE;
+
+    return mmap::GLOBAL_SUCCESS_CODE;
+}
+
+
+void
+mmap::checked_file::mark
+(
+    const size_type offset,
+    const size_type length
+) noexcept
+{
+    // Bitmap covers the capacity seen at open, whatever origin holds now
+    if (!this->checksums || !length || offset >= this->checked_capacity)
+        return;
+
+    const size_type last  = std::min(length, this->checked_capacity - offset) + offset - 1;
+    const size_type first = offset / this->block_size;
+    const size_type final = last / this->block_size;
+
+    for (size_type block = first; block <= final; ++block)
+    {
+        this->dirty[block / DIRTY_WORD_BITS].fetch_or
+        (
+            std::uint64_t(1) << (block % DIRTY_WORD_BITS),
+            std::memory_order_release
+        );
+    }
+}
+
+mmap::status_code
+mmap::checked_file::rehash
+(
+    const size_type thread_count
+) noexcept
+{
+    // Check if opened
+    if (!this->checksums)
+    {
+        util::log::record
+        (
+            "Checksums are not yet open",
+            util::log::type::ERROR
+        );
+
+        return mmap::EXTERNAL_ERROR_CODE;
+    }
+
+    if (this->resized())
+        return mmap::EXTERNAL_ERROR_CODE;
+
+    // Grow side file to one slot per block
+    if (this->checksums->size() < this->block_count && !this->checksums->remap(this->block_count))
+    {
+        util::log::record
+        (
+            "Unable to grow checksum side file",
+            util::log::type::ERROR
+        );
+
+        return mmap::EXTERNAL_ERROR_CODE;
+    }
+
+    mmap::status_code hash_status = this->parallel
+    (
+        thread_count,
+        [this](const size_type first, const size_type last)
+        {
+            for (size_type block = first; block < last; ++block)
+            {
+                (*this->checksums)[block] =
+                {
+                    this->block_crc(block),
+                    static_cast<std::uint32_t>(this->block_size)
+                };
+            }
+        }
+    );
+    if (hash_status == mmap::EXTERNAL_ERROR_CODE)
+        return mmap::EXTERNAL_ERROR_CODE;
+
+    this->checksums->count(this->block_count);
+
+    return this->checksums->flush();
+}
+
+mmap::status_code
+mmap::checked_file::verify
+(
+    const size_type         thread_count,
+    std::vector<size_type> &corrupt_blocks
+) const noexcept
+{
+    // Check if opened
+    if (!this->checksums)
+    {
+        util::log::record
+        (
+            "Checksums are not yet open",
+            util::log::type::ERROR
+        );
+
+        return mmap::EXTERNAL_ERROR_CODE;
+    }
+
+    corrupt_blocks.clear();
+    if (this->resized())
+        return mmap::EXTERNAL_ERROR_CODE;
+
+    // Workers collect locally and merge once
+    std::mutex merge_mutex;
+    bool       merge_failed = false;
+    mmap::status_code scan_status = this->parallel
+    (
+        thread_count,
+        [this, &corrupt_blocks, &merge_mutex, &merge_failed]
+        (const size_type first, const size_type last)
+        {
+            std::vector<size_type> found;
+            try
+            {
+                for (size_type block = first; block < last; ++block)
+                {
+                    if (this->block_crc(block) != (*this->checksums)[block].crc)
+                        found.push_back(block);
+                }
+
+                std::lock_guard<std::mutex> lock(merge_mutex);
+                corrupt_blocks.insert(corrupt_blocks.end(), found.begin(), found.end());
+            }
+
+            catch (const std::exception &exception)
+            {
+                std::lock_guard<std::mutex> lock(merge_mutex);
+                merge_failed = true;
+            }
+        }
+    );
+    if (scan_status == mmap::EXTERNAL_ERROR_CODE || merge_failed)
+    {
+        util::log::record
+        (
+            "Unable to complete checksum verification",
+            util::log::type::ERROR
+        );
+
+        return mmap::EXTERNAL_ERROR_CODE;
+    }
+
+    if (!corrupt_blocks.empty())
+    {
+        std::sort(corrupt_blocks.begin(), corrupt_blocks.end());
+        util::log::record
+        (
+            "Checksum mismatch in " + std::to_string(corrupt_blocks.size()) + " block(s)",
+            util::log::type::ERROR
+        );
+
+        return mmap::EXTERNAL_ERROR_CODE;
+    }
+
+    return mmap::GLOBAL_SUCCESS_CODE;
+}
+
+
+mmap::size_type
+mmap::checked_file::blocks() const noexcept
+{
+    return this->block_count;
+}
+
+
+bool
+mmap::checked_file::resized() const noexcept
+{
+    if (this->origin.capacity() == this->checked_capacity)
+        return false;
+
+    util::log::record
+    (
+        "File was remapped while checked; reopen checksums to continue",
+        util::log::type::ERROR
+    );
+
+    return true;
+}
+
+std::uint32_t
+mmap::checked_file::block_crc
+(
+    const size_type block
+) const noexcept
+{
+    const size_type start  = std::min(block * this->block_size, this->checked_capacity);
+    const size_type length = std::min(this->block_size, this->checked_capacity - start);
+
+    return mmap::checksum::crc32c
+    (
+        static_cast<const std::uint8_t *>(this->origin.address()) + start,
+        length
+    );
+}
+
+template <typename job_type>
+mmap::status_code
+mmap::checked_file::parallel
+(
+    const size_type thread_count,
+    job_type      &&job
+) const noexcept
+{
+    const size_type workers = std::max<size_type>(1, std::min(thread_count, this->block_count));
+
+    // Small files and single thread requests skip the pool
+    if (workers == 1)
+    {
+        job(0, this->block_count);
+        return mmap::GLOBAL_SUCCESS_CODE;
+    }
+
+    try
+    {
+        util::thread::pool pool(workers);
+
+        const size_type stride = (this->block_count + workers - 1) / workers;
+        for (size_type first = 0; first < this->block_count; first += stride)
+        {
+            const size_type last = std::min(first + stride, this->block_count);
+            if (!pool.submit([&job, first, last]() { job(first, last); }))
+            {
+                pool.wait();
+                return mmap::EXTERNAL_ERROR_CODE;
+            }
+        }
+        pool.wait();
+    }
+
+    catch (const std::exception &exception)
+    {
+        util::log::record
+        (
+            "Unable to start checksum workers",
+            util::log::type::ERROR
+        );
+
+        return mmap::EXTERNAL_ERROR_CODE;
+    }
+
+    return mmap::GLOBAL_SUCCESS_CODE;
+}
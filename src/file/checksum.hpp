@@ -0,0 +1,130 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "file/file.hpp"
+#include "file/ordered_file.hpp"
+
+
+namespace mmap
+{
+
+namespace checksum
+{
+
+// Castagnoli CRC; hardware instruction when the processor supports it
+std::uint32_t
+crc32c
+(
+    const void          *data,
+    const size_type      length,
+    const std::uint32_t  seed = 0
+) noexcept;
+
+} // checksum namespace
+
+// Side file slot; block size kept per slot so a mismatched layout is caught
+struct block_checksum
+{
+    std::uint32_t crc;
+    std::uint32_t block_size;
+};
+
+// Per-block checksums of a mapped file kept in a side file; writers mark
+// the ranges they touch and flush rehashes only those blocks. The origin
+// must not be remapped while checked; close and reopen around a resize
+class checked_file
+{
+protected:
+    // Shared mapping the checksums describe
+    file                                          &origin;
+
+    // User provided metadata
+    std::string                                    checksum_path;
+    size_type                                      block_size;
+
+    // Internal metadata
+    std::unique_ptr<ordered_file<block_checksum>>  checksums;
+    std::unique_ptr<std::atomic<std::uint64_t>[]>  dirty;
+    size_type                                      block_count = 0;
+    size_type                                      checked_capacity = 0;
+
+public:
+    checked_file
+    (
+        // Required parameters
+        file              &origin,
+        const std::string &checksum_path,
+
+        // Advanced parameters
+        const size_type    block_size = 4096
+    );
+
+    virtual ~checked_file() noexcept;
+
+    // No copies permitted
+    checked_file(const checked_file &other)           = delete;
+    checked_file operator=(const checked_file &other) = delete;
+
+    status_code
+    virtual open
+    (
+        const size_type thread_count = 1
+    ) noexcept;
+    status_code
+    virtual flush() noexcept;
+    status_code
+    virtual close() noexcept;
+
+    // Safe to call from concurrent writers
+    void
+    mark
+    (
+        const size_type offset,
+        const size_type length
+    ) noexcept;
+
+    // Recompute every block, discarding stored checksums
+    status_code
+    rehash
+    (
+        const size_type thread_count
+    ) noexcept;
+
+    // Compare every block against its stored checksum; fails on mismatch
+    status_code
+    verify
+    (
+        const size_type         thread_count,
+        std::vector<size_type> &corrupt_blocks
+    ) const noexcept;
+
+    size_type
+    blocks() const noexcept;
+
+protected:
+    // True, with an error logged, once origin capacity differs from open
+    bool
+    resized() const noexcept;
+
+    std::uint32_t
+    block_crc
+    (
+        const size_type block
+    ) const noexcept;
+
+    // Run job over contiguous block ranges, one per thread
+    template <typename job_type>
+    status_code
+    parallel
+    (
+        const size_type thread_count,
+        job_type      &&job
+    ) const noexcept;
+};
+
+} // mmap namespace
@@ -0,0 +1,139 @@
+#pragma once
+
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "file/ordered_file.hpp"
+
+
+namespace mmap
+{
+
+// Contiguous typed view over one mapped column
+template <typename data_type>
+class column_view
+{
+private:
+    data_type *column_data;
+    size_type  column_size;
+
+public:
+    column_view
+    (
+        data_type       *column_data,
+        const size_type  column_size
+    ) noexcept;
+
+    data_type *
+    data() const noexcept;
+    size_type
+    size() const noexcept;
+
+    data_type *
+    begin() const noexcept;
+    data_type *
+    end() const noexcept;
+
+    data_type &
+    operator[]
+    (
+        const size_type index
+    ) const noexcept;
+};
+
+// Struct-of-arrays table storing each record field in its own file
+template <typename record_type, auto... fields>
+class columnar_file
+{
+public:
+    template <auto field>
+    using field_type = std::remove_cv_t<std::remove_reference_t<
+        decltype(std::declval<record_type &>().*field)
+    >>;
+
+    template <size_type index>
+    using column_type = std::tuple_element_t<index, std::tuple<field_type<fields>...>>;
+
+    static constexpr size_type column_count = sizeof...(fields);
+
+private:
+    // User provided table metadata
+    std::string table_path;
+    size_type   table_capacity;
+
+    // One ordered file per field, suffixed by field position
+    std::tuple<std::unique_ptr<ordered_file<field_type<fields>>>...> columns;
+
+public:
+    columnar_file
+    (
+        // Required parameters
+        const std::string            &table_path,
+        const size_type               table_capacity,
+
+        // System call flags
+        const sys::file::flag_code    open_flag     = O_RDWR | O_CREAT,
+        const sys::file::flag_code    lock_flag     = LOCK_SH,
+        const sys::memory::flag_code  protocol_flag = PROT_READ | PROT_WRITE,
+        const sys::memory::flag_code  mapping_flag  = MAP_SHARED,
+        const sys::memory::flag_code  sync_flag     = MS_ASYNC,
+        const sys::memory::flag_code  remap_flag    = MREMAP_MAYMOVE
+    );
+
+    virtual ~columnar_file() noexcept = default;
+
+    // No copies permitted
+    columnar_file(const columnar_file &other)           = delete;
+    columnar_file operator=(const columnar_file &other) = delete;
+
+    size_type
+    size() const noexcept;
+
+    template <size_type index>
+    column_view<column_type<index>>
+    column() const noexcept;
+
+    record_type
+    row
+    (
+        const size_type index
+    ) const noexcept;
+    void
+    assign
+    (
+        const size_type    index,
+        const record_type &record
+    ) const noexcept;
+
+    status_code
+    virtual open() noexcept;
+    status_code
+    virtual flush() noexcept;
+    status_code
+    virtual close() noexcept;
+    status_code
+    virtual remap
+    (
+        const size_type table_capacity
+    ) noexcept;
+
+protected:
+    static std::string column_path
+    (
+        const std::string &table_path,
+        const size_type    index
+    );
+
+    template <typename function_type>
+    status_code
+    for_each_column
+    (
+        function_type &&function
+    ) noexcept;
+};
+
+} // mmap namespace
+
+#include "file/columnar_file.tpp"
@@ -0,0 +1,286 @@
+#include <exception>
+#include <stdexcept>
+#include <string>
+
+#include <util/record.hpp>
+
+
+template <typename data_type>
+mmap::column_view<data_type>::column_view
+(
+    data_type       *column_data,
+    const size_type  column_size
+) noexcept
+{
+    this->column_data = column_data;
+    this->column_size = column_size;
+}
+
+template <typename data_type>
+data_type *
+mmap::column_view<data_type>::data() const noexcept
+{
+    return this->column_data;
+}
+
+template <typename data_type>
+mmap::size_type
+mmap::column_view<data_type>::size() const noexcept
+{
+    return this->column_size;
+}
+
+template <typename data_type>
+data_type *
+mmap::column_view<data_type>::begin() const noexcept
+{
+    return this->column_data;
+}
+
+template <typename data_type>
+data_type *
+mmap::column_view<data_type>::end() const noexcept
+{
+    return this->column_data + this->column_size;
+}
+
+template <typename data_type>
+data_type &
+mmap::column_view<data_type>::operator[]
+(
+    const size_type index
+) const noexcept
+{
+    return this->column_data[index];
+}
+
+
+template <typename record_type, auto... fields>
+mmap::columnar_file<record_type, fields...>::columnar_file
+(
+    // Required parameters
+    const std::string            &table_path,
+    const size_type               table_capacity,
+
+    // System call flags
+    const sys::file::flag_code    open_flag,
+    const sys::file::flag_code    lock_flag,
+    const sys::memory::flag_code  protocol_flag,
+    const sys::memory::flag_code  mapping_flag,
+    const sys::memory::flag_code  sync_flag,
+    const sys::memory::flag_code  remap_flag
+)
+{
+    static_assert
+    (
+        (std::is_member_object_pointer_v<decltype(fields)> && ...),
+        "Columns must be given as pointers to data members of the record"
+    );
+    static_assert
+    (
+        (std::is_trivially_copyable_v<field_type<fields>> && ...),
+        "Mapped columns must be trivially copyable"
+    );
+
+    // metadata
+    this->table_path     = table_path;
+    this->table_capacity = table_capacity;
+
+    // Column files; ordered file validates each path
+    size_type index = 0;
+    std::apply
+    (
+        [&](auto &...column)
+        {
+            ((
+                column = std::make_unique
+                <
+                    typename std::remove_reference_t<decltype(column)>::element_type
+                >
+                (
+                    columnar_file::column_path(table_path, index++),
+                    table_capacity,
+                    0,
+                    nullptr,
+                    open_flag,
+                    lock_flag,
+                    protocol_flag,
+                    mapping_flag,
+                    sync_flag,
+                    remap_flag
+                )
+            ), ...);
+        },
+        this->columns
+    );
+}
+
+
+template <typename record_type, auto... fields>
+mmap::size_type
+mmap::columnar_file<record_type, fields...>::size() const noexcept
+{
+    return this->table_capacity;
+}
+
+template <typename record_type, auto... fields>
+template <mmap::size_type index>
+mmap::column_view<typename mmap::columnar_file<record_type, fields...>::template column_type<index>>
+mmap::columnar_file<record_type, fields...>::column() const noexcept
+{
+    const auto &column = std::get<index>(this->columns);
+
+    return column_view<column_type<index>>
+    (
+        column->data(),
+        column->size()
+    );
+}
+
+template <typename record_type, auto... fields>
+record_type
+mmap::columnar_file<record_type, fields...>::row
+(
+    const size_type index
+) const noexcept
+{
+    // Gather one element from every column
+    record_type record{};
+    std::apply
+    (
+        [&](const auto &...column)
+        {
+            ((record.*fields = (*column)[index]), ...);
+        },
+        this->columns
+    );
+
+    return record;
+}
+
+template <typename record_type, auto... fields>
+void
+mmap::columnar_file<record_type, fields...>::assign
+(
+    const size_type    index,
+    const record_type &record
+) const noexcept
+{
+    // Scatter record fields into their columns
+    std::apply
+    (
+        [&](const auto &...column)
+        {
+            (((*column)[index] = record.*fields), ...);
+        },
+        this->columns
+    );
+}
+
+
+template <typename record_type, auto... fields>
+mmap::status_code
+mmap::columnar_file<record_type, fields...>::open() noexcept
+{
+    return this->for_each_column
+    (
+        [](auto &column) -> status_code
+        {
+            return column->open()
+                ? mmap::GLOBAL_SUCCESS_CODE
+                : mmap::EXTERNAL_ERROR_CODE;
+        }
+    );
+}
+
+template <typename record_type, auto... fields>
+mmap::status_code
+mmap::columnar_file<record_type, fields...>::flush() noexcept
+{
+    return this->for_each_column
+    (
+        [](auto &column) -> status_code
+        {
+            return column->flush();
+        }
+    );
+}
+
+template <typename record_type, auto... fields>
+mmap::status_code
+mmap::columnar_file<record_type, fields...>::close() noexcept
+{
+    return this->for_each_column
+    (
+        [](auto &column) -> status_code
+        {
+            return column->close();
+        }
+    );
+}
+
+template <typename record_type, auto... fields>
+mmap::status_code
+mmap::columnar_file<record_type, fields...>::remap
+(
+    const size_type table_capacity
+) noexcept
+{
+    mmap::status_code remap_status = this->for_each_column
+    (
+        [table_capacity](auto &column) -> status_code
+        {
+            return column->remap(table_capacity)
+                ? mmap::GLOBAL_SUCCESS_CODE
+                : mmap::EXTERNAL_ERROR_CODE;
+        }
+    );
+    if (remap_status == mmap::EXTERNAL_ERROR_CODE)
+    {
+        util::log::record
+        (
+            "Unable to reallocate every column of table; "
+            "columns may differ in capacity",
+            util::log::type::ERROR
+        );
+
+        return mmap::EXTERNAL_ERROR_CODE;
+    }
+    this->table_capacity = table_capacity;
+
+    return mmap::GLOBAL_SUCCESS_CODE;
+}
+
+
+template <typename record_type, auto... fields>
+std::string
+mmap::columnar_file<record_type, fields...>::column_path
+(
+    const std::string &table_path,
+    const size_type    index
+)
+{
+    return table_path + "." + std::to_string(index);
+}
+
+template <typename record_type, auto... fields>
+template <typename function_type>
+mmap::status_code
+mmap::columnar_file<record_type, fields...>::for_each_column
+(
+    function_type &&function
+) noexcept
+{
+    // Visit every column even after a failure so none is left half done
+    bool failed = false;
+    std::apply
+    (
+        [&](auto &...column)
+        {
+            ((failed |= function(column) == mmap::EXTERNAL_ERROR_CODE), ...);
+        },
+        this->columns
+    );
+
+    return failed ? mmap::EXTERNAL_ERROR_CODE : mmap::GLOBAL_SUCCESS_CODE;
+}
@@ -0,0 +1,590 @@
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <exception>
+#include <filesystem>
+#include <functional>
+#include <stdexcept>
+
+#include <util/pool.hpp>
+#include <util/record.hpp>
+
+#include "checksum.hpp"
+#include "commit_group.hpp"
+
+
+namespace
+{
+
+constexpr std::uint64_t MANIFEST_MAGIC = 0x54494d4d4f43504d;  // "MPCOMMIT"
+
+// Each slot on its own page so one write cannot tear both
+constexpr mmap::size_type MANIFEST_SLOTS      = 2;
+constexpr mmap::size_type MANIFEST_SLOT_BYTES = 4096;
+
+using job_type = std::function<bool()>;
+
+std::uint32_t
+record_crc
+(
+    const mmap::commit_record &record
+) noexcept
+{
+    return mmap::checksum::crc32c(&record, offsetof(mmap::commit_record, crc));
+}
+
+// Run every job, inline for one thread; true only if all succeed
+bool
+run_jobs
+(
+    const std::vector<job_type> &jobs,
+    const mmap::size_type        thread_count
+) noexcept
+{
+    std::atomic<bool> failed{false};
+    auto guarded = [&failed](const job_type &job)
+    {
+        try
+        {
+            if (!job())
+                failed.store(true, std::memory_order_relaxed);
+        }
+
+        catch (...)
+        {
+            failed.store(true, std::memory_order_relaxed);
+        }
+    };
+
+    const mmap::size_type workers = std::min(thread_count, jobs.size());
+    if (workers <= 1)
+    {
+        for (const job_type &job: jobs)
+            guarded(job);
+
+        return !failed;
+    }
+
+    try
+    {
+        util::thread::pool pool(workers);
+        for (const job_type &job: jobs)
+        {
+            if (!pool.submit([&guarded, &job]() { guarded(job); }))
+                failed.store(true, std::memory_order_relaxed);
+        }
+        pool.wait();
+    }
+
+    catch (...)
+    {
+        util::log::record
+        (
+            "Unable to start commit workers",
+            util::log::type::ERROR
+        );
+
+        return false;
+    }
+
+    return !failed;
+}
+
+// Make a new directory entry durable
+mmap::status_code
+sync_directory
+(
+    const std::string &path
+) noexcept
+{
+    std::string directory;
+    try
+    {
+        directory = std::filesystem::path(path).parent_path().string();
+    }
+
+    catch (...)
+    {
+        return mmap::EXTERNAL_ERROR_CODE;
+    }
+    if (directory.empty())
+        directory = ".";
+
+    sys::file::descriptor directory_descriptor = sys::file::open
+    (
+        directory.c_str(),
+        O_RDONLY | O_DIRECTORY | O_CLOEXEC
+    );
+    if (directory_descriptor == mmap::INTERNAL_ERROR_CODE
+        || sys::file::sync_all(directory_descriptor) == mmap::INTERNAL_ERROR_CODE)
+    {
+        util::log::record
+        (
+            "Unable to make manifest directory entry durable",
+            util::log::type::ERROR
+        );
+
+        if (directory_descriptor != mmap::INTERNAL_ERROR_CODE)
+            sys::file::close(directory_descriptor);
+        return mmap::EXTERNAL_ERROR_CODE;
+    }
+    sys::file::close(directory_descriptor);
+
+    return mmap::GLOBAL_SUCCESS_CODE;
+}
+
+} // anonymous namespace
+
+
+mmap::commit_group::commit_group
+(
+    // Required parameters
+    const std::string &manifest_path
+)
+{
+    // Validate manifest path
+    if (!mmap::file::valid_path(manifest_path))
+    {
+        util::log::record
+        (
+            "Manifest does not have a valid path: "
+            "parent directory and/or file path does not exist",
+            util::log::type::ABORT
+        );
+
+        throw std::runtime_error("Provided manifest path is invalid");
+    }
+
+    // metadata
+    this->manifest_path = manifest_path;
+}
+
+mmap::commit_group::~commit_group() noexcept
+{
+    if (this->manifest_descriptor != mmap::INTERNAL_ERROR_CODE)
+        this->close();
+}
+
+
+mmap::status_code
+mmap::commit_group::open() noexcept
+{
+    // Check if opened
+    if (this->manifest_descriptor != mmap::INTERNAL_ERROR_CODE)
+    {
+        util::log::record
+        (
+            "Manifest is already open",
+            util::log::type::ERROR
+        );
+
+        return mmap::EXTERNAL_ERROR_CODE;
+    }
+
+    // Open manifest, noting whether this call creates it
+    bool created = true;
+    sys::file::descriptor manifest_descriptor = sys::file::open
+    (
+        this->manifest_path.c_str(),
+        O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC,
+        mmap::CREATE_MODE
+    );
+    if (manifest_descriptor == mmap::INTERNAL_ERROR_CODE && errno == EEXIST)
+    {
+        created             = false;
+        manifest_descriptor = sys::file::open
+        (
+            this->manifest_path.c_str(),
+            O_RDWR | O_CLOEXEC
+        );
+    }
+    if (manifest_descriptor == mmap::INTERNAL_ERROR_CODE)
+    {
+        util::log::record
+        (
+            "Unable to open manifest",
+            util::log::type::ERROR
+        );
+
+        return mmap::EXTERNAL_ERROR_CODE;
+    }
+    this->manifest_descriptor = manifest_descriptor;
+
+    // One committer per manifest
+    if (sys::file::lock(this->manifest_descriptor, LOCK_EX | LOCK_NB) == mmap::INTERNAL_ERROR_CODE)
+    {
+        util::log::record
+        (
+            "Manifest is held by another commit group",
+            util::log::type::ERROR
+        );
+
+        this->close();
+        return mmap::EXTERNAL_ERROR_CODE;
+    }
+
+    // A new manifest must survive a crash as well as its records
+    if (created && sync_directory(this->manifest_path) == mmap::EXTERNAL_ERROR_CODE)
+    {
+        this->close();
+        return mmap::EXTERNAL_ERROR_CODE;
+    }
+
+    return this->recover();
+}
+
+mmap::status_code
+mmap::commit_group::close() noexcept
+{
+    // Check if opened
+    if (this->manifest_descriptor == mmap::INTERNAL_ERROR_CODE)
+    {
+        util::log::record
+        (
+            "Manifest is not open",
+            util::log::type::ERROR
+        );
+
+        return mmap::EXTERNAL_ERROR_CODE;
+    }
+
+    // Pending marks are dropped; commit first to keep them
+    sys::file::status_code close_status = sys::file::close(this->manifest_descriptor);
+    this->manifest_descriptor = mmap::INTERNAL_ERROR_CODE;
+    if (close_status == mmap::INTERNAL_ERROR_CODE)
+    {
+        util::log::record
+        (
+            "Unable to close manifest",
+            util::log::type::ERROR
+        );
+
+        return mmap::EXTERNAL_ERROR_CODE;
+    }
+
+    return mmap::GLOBAL_SUCCESS_CODE;
+}
+
+
+mmap::status_code
+mmap::commit_group::add
+(
+    file &origin
+) noexcept
+{
+    // Only mapped shared files reach the backing store
+    if (!origin.address() || !(origin.mapping() & MAP_SHARED))
+    {
+        util::log::record
+        (
+            "Commit group members must be open shared mappings",
+            util::log::type::ERROR
+        );
+
+        return mmap::EXTERNAL_ERROR_CODE;
+    }
+
+    std::lock_guard<std::mutex> commit_lock(this->commit_mutex);
+    std::lock_guard<std::mutex> mark_lock(this->mark_mutex);
+    try
+    {
+        this->members.push_back({&origin, {}});
+    }
+
+    catch (const std::exception &exception)
+    {
+        return mmap::EXTERNAL_ERROR_CODE;
+    }
+
+    return mmap::GLOBAL_SUCCESS_CODE;
+}
+
+mmap::status_code
+mmap::commit_group::mark
+(
+    const size_type member_index,
+    const size_type offset,
+    const size_type length
+) noexcept
+{
+    std::lock_guard<std::mutex> lock(this->mark_mutex);
+
+    // Check member and range
+    if (member_index >= this->members.size())
+    {
+        util::log::record
+        (
+            "Commit group member index out of range",
+            util::log::type::ERROR
+        );
+
+        return mmap::EXTERNAL_ERROR_CODE;
+    }
+
+    member &target = this->members[member_index];
+    if (!length || offset >= target.origin->capacity())
+        return mmap::GLOBAL_SUCCESS_CODE;
+
+    try
+    {
+        target.ranges.emplace_back
+        (
+            offset,
+            std::min(length, target.origin->capacity() - offset)
+        );
+    }
+
+    catch (const std::exception &exception)
+    {
+        return mmap::EXTERNAL_ERROR_CODE;
+    }
+
+    return mmap::GLOBAL_SUCCESS_CODE;
+}
+
+mmap::status_code
+mmap::commit_group::mark
+(
+    const size_type member_index
+) noexcept
+{
+    // Members may be added concurrently; an unknown index is reported below
+    size_type capacity = 0;
+    {
+        std::lock_guard<std::mutex> lock(this->mark_mutex);
+        if (member_index < this->members.size())
+            capacity = this->members[member_index].origin->capacity();
+    }
+
+    return this->mark(member_index, 0, capacity);
+}
+
+
+mmap::status_code
+mmap::commit_group::commit
+(
+    const size_type     thread_count,
+    const std::uint64_t tag
+) noexcept
+{
+    // Check if opened
+    if (this->manifest_descriptor == mmap::INTERNAL_ERROR_CODE)
+    {
+        util::log::record
+        (
+            "Manifest is not open",
+            util::log::type::ERROR
+        );
+
+        return mmap::EXTERNAL_ERROR_CODE;
+    }
+
+    std::lock_guard<std::mutex> commit_lock(this->commit_mutex);
+
+    // Take marks made so far; later marks belong to the next group
+    std::vector<std::vector<range_type>> pending(this->members.size());
+    {
+        std::lock_guard<std::mutex> mark_lock(this->mark_mutex);
+        for (size_type index = 0; index < this->members.size(); ++index)
+            pending[index].swap(this->members[index].ranges);
+    }
+
+    // Return marks so a failed group is retried whole by the next commit
+    auto requeue = [this, &pending]()
+    {
+        std::lock_guard<std::mutex> mark_lock(this->mark_mutex);
+        for (size_type index = 0; index < pending.size(); ++index)
+        {
+            std::vector<range_type> &ranges = this->members[index].ranges;
+            ranges.insert(ranges.end(), pending[index].begin(), pending[index].end());
+        }
+    };
+
+    std::vector<job_type> writeback_jobs;
+    std::vector<job_type> sync_jobs;
+    try
+    {
+        for (size_type index = 0; index < pending.size(); ++index)
+        {
+            coalesce(pending[index]);
+            if (pending[index].empty())
+                continue;
+
+            const file *origin = this->members[index].origin;
+            for (const range_type &range: pending[index])
+            {
+                // Start writeback only; durability comes from the barrier
+                writeback_jobs.push_back([origin, range]()
+                {
+                    sys::file::writeback
+                    (
+                        origin->descriptor(),
+                        origin->offset() + range.first,
+                        range.second,
+                        SYNC_FILE_RANGE_WRITE
+                    );
+
+                    return true;
+                });
+            }
+
+            sync_jobs.push_back([origin]()
+            {
+                return sys::file::sync(origin->descriptor()) != mmap::INTERNAL_ERROR_CODE;
+            });
+        }
+    }
+
+    catch (const std::exception &exception)
+    {
+        requeue();
+        return mmap::EXTERNAL_ERROR_CODE;
+    }
+
+    // Queue every member's writes before waiting on any of them
+    run_jobs(writeback_jobs, thread_count);
+
+    // Durability barrier: data of every member before the manifest
+    if (!run_jobs(sync_jobs, thread_count))
+    {
+        util::log::record
+        (
+            "Unable to make commit group members durable",
+            util::log::type::ERROR
+        );
+
+        requeue();
+        return mmap::EXTERNAL_ERROR_CODE;
+    }
+
+    // Record group in the slot not holding the last one
+    commit_record record = {};
+    record.magic        = MANIFEST_MAGIC;
+    record.sequence     = this->last_record.sequence + 1;
+    record.tag          = tag;
+    record.member_count = this->members.size();
+    record.timestamp    = std::chrono::duration_cast<std::chrono::nanoseconds>
+    (
+        std::chrono::system_clock::now().time_since_epoch()
+    ).count();
+    record.crc          = record_crc(record);
+
+    const off_t slot_offset = (record.sequence % MANIFEST_SLOTS) * MANIFEST_SLOT_BYTES;
+    ssize_t write_status = sys::file::write
+    (
+        this->manifest_descriptor,
+        &record,
+        sizeof(record),
+        slot_offset
+    );
+    if (write_status != static_cast<ssize_t>(sizeof(record))
+        || sys::file::sync(this->manifest_descriptor) == mmap::INTERNAL_ERROR_CODE)
+    {
+        util::log::record
+        (
+            "Unable to record commit group in manifest",
+            util::log::type::ERROR
+        );
+
+        requeue();
+        return mmap::EXTERNAL_ERROR_CODE;
+    }
+    this->last_record = record;
+
+    return mmap::GLOBAL_SUCCESS_CODE;
+}
+
+
+std::uint64_t
+mmap::commit_group::sequence() const noexcept
+{
+    return this->last_record.sequence;
+}
+
+std::uint64_t
+mmap::commit_group::tag() const noexcept
+{
+    return this->last_record.tag;
+}
+
+
+mmap::status_code
+mmap::commit_group::recover() noexcept
+{
+    this->last_record = {};
+
+    // Newest slot passing its checksum is the last completed group
+    for (size_type slot = 0; slot < MANIFEST_SLOTS; ++slot)
+    {
+        commit_record record = {};
+        ssize_t read_status = sys::file::read
+        (
+            this->manifest_descriptor,
+            &record,
+            sizeof(record),
+            slot * MANIFEST_SLOT_BYTES
+        );
+        if (read_status == mmap::INTERNAL_ERROR_CODE)
+        {
+            util::log::record
+            (
+                "Unable to read manifest",
+                util::log::type::ERROR
+            );
+
+            return mmap::EXTERNAL_ERROR_CODE;
+        }
+
+        // Short read is a fresh manifest; bad checksum is a torn slot
+        if (read_status != static_cast<ssize_t>(sizeof(record))
+            || record.magic != MANIFEST_MAGIC || record.crc != record_crc(record))
+            continue;
+
+        if (record.sequence > this->last_record.sequence)
+            this->last_record = record;
+    }
+
+    return mmap::GLOBAL_SUCCESS_CODE;
+}
+
+void
+mmap::commit_group::coalesce
+(
+    std::vector<range_type> &ranges
+) noexcept
+{
+    if (ranges.empty())
+        return;
+
+    // Writeback works in pages
+    const size_type page_size = sys::memory::page_size;
+    for (range_type &range: ranges)
+    {
+        const size_type first = range.first / page_size * page_size;
+        const size_type last  = range.first + range.second;
+        range = {first, last - first};
+    }
+
+    std::sort(ranges.begin(), ranges.end());
+
+    size_type merged = 0;
+    for (size_type index = 1; index < ranges.size(); ++index)
+    {
+        range_type &current = ranges[merged];
+        if (ranges[index].first <= current.first + current.second)
+        {
+            const size_type last = std::max
+            (
+                current.first + current.second,
+                ranges[index].first + ranges[index].second
+            );
+            current.second = last - current.first;
+        }
+
+        else
+            ranges[++merged] = ranges[index];
+    }
+    ranges.resize(merged + 1);
+}
@@ -0,0 +1,121 @@
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "file/file.hpp"
+
+
+namespace mmap
+{
+
+// Manifest slot; slots alternate so a torn write leaves the previous
+// group readable
+struct commit_record
+{
+    std::uint64_t magic;
+    std::uint64_t sequence;
+    std::uint64_t tag;
+    std::uint64_t member_count;
+    std::uint64_t timestamp;
+    std::uint32_t reserved;
+    std::uint32_t crc;
+};
+
+// Shared mappings written back together; a group counts as committed once
+// its record reaches the manifest, after every member's data is durable
+class commit_group
+{
+protected:
+    using range_type = std::pair<size_type, size_type>;
+
+    // Member mapping and the byte ranges dirtied since last commit
+    struct member
+    {
+        file                    *origin;
+        std::vector<range_type>  ranges;
+    };
+
+    // User provided metadata
+    std::string           manifest_path;
+
+    // Internal metadata
+    sys::file::descriptor manifest_descriptor = mmap::INTERNAL_ERROR_CODE;
+    std::vector<member>   members;
+    commit_record         last_record         = {};
+
+    // Marks may race each other; commits run one at a time
+    std::mutex            mark_mutex;
+    std::mutex            commit_mutex;
+
+public:
+    commit_group
+    (
+        // Required parameters
+        const std::string &manifest_path
+    );
+
+    virtual ~commit_group() noexcept;
+
+    // No copies permitted
+    commit_group(const commit_group &other)           = delete;
+    commit_group operator=(const commit_group &other) = delete;
+
+    // Open manifest and recover last completed group
+    status_code
+    virtual open() noexcept;
+    status_code
+    virtual close() noexcept;
+
+    // Register a mapped shared file; members are indexed in order added
+    status_code
+    add
+    (
+        file &origin
+    ) noexcept;
+
+    // Safe to call from concurrent writers
+    status_code
+    mark
+    (
+        const size_type member_index,
+        const size_type offset,
+        const size_type length
+    ) noexcept;
+    status_code
+    mark
+    (
+        const size_type member_index
+    ) noexcept;
+
+    // Write back dirty ranges in parallel, wait for all members to be
+    // durable, then record the group in the manifest
+    status_code
+    virtual commit
+    (
+        const size_type     thread_count = 1,
+        const std::uint64_t tag          = 0
+    ) noexcept;
+
+    // Last completed group, zero before the first
+    std::uint64_t
+    sequence() const noexcept;
+    std::uint64_t
+    tag() const noexcept;
+
+protected:
+    status_code
+    recover() noexcept;
+
+    // Page align and coalesce ranges of one member
+    static void
+    coalesce
+    (
+        std::vector<range_type> &ranges
+    ) noexcept;
+};
+
+} // mmap namespace
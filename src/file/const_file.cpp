@@ -0,0 +1,151 @@
+#include <stdexcept>
+#include <string>
+
+#include <util/record.hpp>
+
+#include "const_file.hpp"
+
+
+mmap::const_file::const_file
+(
+    // Required parameters
+    const std::string            &file_path,
+
+    // System call flags
+    const sys::memory::flag_code  mapping_flag
+)
+{
+    // metadata
+    this->file_path           = file_path;
+    this->file_capacity_bytes = 0;
+    this->file_address        = nullptr;
+
+    // Open file read only; no lock is taken and size is never changed
+    sys::file::descriptor file_descriptor = sys::file::open
+    (
+        this->file_path.c_str(),
+        O_RDONLY | O_CLOEXEC
+    );
+    if (file_descriptor == mmap::INTERNAL_ERROR_CODE)
+    {
+        util::log::record
+        (
+            "Unable to open file and failed to recieve file descriptor",
+            util::log::type::ABORT
+        );
+
+        throw std::runtime_error("Provided file could not be opened");
+    }
+
+    // Size mapping from file
+    struct stat file_status;
+    sys::file::status_code status_status = sys::file::status
+    (
+        file_descriptor,
+        &file_status
+    );
+    if (status_status == mmap::INTERNAL_ERROR_CODE)
+    {
+        util::log::record
+        (
+            "Unable to read file status",
+            util::log::type::ABORT
+        );
+
+        sys::file::close(file_descriptor);
+        throw std::runtime_error("Provided file size could not be read");
+    }
+    this->file_capacity_bytes = file_status.st_size;
+
+    // Empty files have nothing to map
+    if (this->file_capacity_bytes)
+    {
+        address_type file_address = sys::memory::map
+        (
+            nullptr,
+            this->file_capacity_bytes,
+            PROT_READ,
+            mapping_flag,
+            file_descriptor,
+            0
+        );
+        if (file_address == MAP_FAILED)
+        {
+            util::log::record
+            (
+                "Unable to allocate a mapping from a file address to file",
+                util::log::type::ABORT
+            );
+
+            sys::file::close(file_descriptor);
+            throw std::runtime_error("Provided file could not be mapped");
+        }
+        this->file_address = file_address;
+    }
+
+    // Mapping outlives its descriptor
+    sys::file::close(file_descriptor);
+}
+
+mmap::const_file::~const_file() noexcept
+{
+    if (!this->file_address)
+        return;
+
+    sys::memory::status_code unmap_status = sys::memory::unmap
+    (
+        this->file_address,
+        this->file_capacity_bytes
+    );
+    if (unmap_status == mmap::INTERNAL_ERROR_CODE)
+    {
+        util::log::record
+        (
+            "Unable to unmap file from file address",
+            util::log::type::ERROR
+        );
+    }
+}
+
+
+const void *
+mmap::const_file::address() const noexcept
+{
+    return this->file_address;
+}
+
+mmap::size_type
+mmap::const_file::capacity() const noexcept
+{
+    return this->file_capacity_bytes;
+}
+
+
+mmap::status_code
+mmap::const_file::advise
+(
+    const sys::memory::flag_code advice
+) const noexcept
+{
+    if (!this->file_address)
+        return mmap::GLOBAL_SUCCESS_CODE;
+
+    sys::memory::status_code advise_status = sys::memory::advise
+    (
+        this->file_address,
+        this->file_capacity_bytes,
+        advice
+    );
+    if (advise_status == mmap::INTERNAL_ERROR_CODE)
+    {
+        util::log::record
+        (
+            "Unable to advise kernel on mapping access",
+            util::log::type::ERROR
+        );
+
+        return mmap::EXTERNAL_ERROR_CODE;
+    }
+
+    return mmap::GLOBAL_SUCCESS_CODE;
+}
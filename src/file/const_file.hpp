@@ -0,0 +1,71 @@
+#pragma once
+
+#include <string>
+
+#include "file/file.hpp"
+
+
+namespace mmap
+{
+
+// Read-only mapping opened once at construction; every member is const so
+// one instance can be shared by reference across threads
+class const_file
+{
+private:
+    // Internal file metadata
+    std::string  file_path;
+    size_type    file_capacity_bytes;
+    address_type file_address;
+
+public:
+    const_file
+    (
+        // Required parameters
+        const std::string            &file_path,
+
+        // System call flags
+        const sys::memory::flag_code  mapping_flag = MAP_SHARED
+    );
+
+    ~const_file() noexcept;
+
+    // No copies permitted
+    const_file(const const_file &other)           = delete;
+    const_file operator=(const const_file &other) = delete;
+
+    const void *
+    address() const noexcept;
+    size_type
+    capacity() const noexcept;
+
+    template <typename data_type>
+    const data_type *
+    data() const noexcept;
+    template <typename data_type>
+    size_type
+    size() const noexcept;
+
+    status_code
+    advise
+    (
+        const sys::memory::flag_code advice
+    ) const noexcept;
+};
+
+} // mmap namespace
+
+
+template <typename data_type>
+const data_type *
+mmap::const_file::data() const noexcept
+{
+    return static_cast<const data_type *>(this->file_address);
+}
+
+template <typename data_type>
+mmap::size_type
+mmap::const_file::size() const noexcept
+{
+    return this->file_capacity_bytes / sizeof(data_type);
+}
@@ -0,0 +1,193 @@
+#include <algorithm>
+#include <cerrno>
+
+#include <util/record.hpp>
+
+#include "extent.hpp"
+
+
+mmap::extent_iterator::extent_iterator
+(
+    const sys::file::descriptor file_descriptor,
+    const size_type             range_begin,
+    const size_type             range_end,
+    const size_type             unit_size
+) noexcept
+{
+    this->file_descriptor = file_descriptor;
+    this->range_begin     = range_begin;
+    this->range_end       = range_end;
+    this->unit_size       = unit_size;
+
+    this->position  = range_begin;
+    this->current   = {0, 0};
+    this->exhausted = false;
+
+    this->advance();
+}
+
+
+mmap::extent_iterator::reference
+mmap::extent_iterator::operator*() const noexcept
+{
+    return this->current;
+}
+
+mmap::extent_iterator::pointer
+mmap::extent_iterator::operator->() const noexcept
+{
+    return &this->current;
+}
+
+
+mmap::extent_iterator &
+mmap::extent_iterator::operator++() noexcept
+{
+    this->advance();
+
+    return *this;
+}
+
+mmap::extent_iterator
+mmap::extent_iterator::operator++(int) noexcept
+{
+    extent_iterator previous = *this;
+    this->advance();
+
+    return previous;
+}
+
+
+bool
+mmap::extent_iterator::operator==
+(
+    const extent_iterator &other
+) const noexcept
+{
+    if (this->exhausted || other.exhausted)
+        return this->exhausted == other.exhausted;
+
+    return this->file_descriptor == other.file_descriptor
+        && this->position        == other.position;
+}
+
+bool
+mmap::extent_iterator::operator!=
+(
+    const extent_iterator &other
+) const noexcept
+{
+    return !(*this == other);
+}
+
+
+void
+mmap::extent_iterator::advance() noexcept
+{
+    if (this->position >= this->range_end)
+    {
+        this->exhausted = true;
+        return;
+    }
+
+    // Seek next allocated byte at or after position
+    off_t data = sys::file::seek
+    (
+        this->file_descriptor,
+        this->position,
+        SEEK_DATA
+    );
+    if (data == mmap::INTERNAL_ERROR_CODE)
+    {
+        // No data remains before end of file
+        if (errno != ENXIO)
+        {
+            util::log::record
+            (
+                "Unable to seek to next data extent of file",
+                util::log::type::ERROR
+            );
+        }
+
+        this->exhausted = true;
+        return;
+    }
+    if (static_cast<size_type>(data) >= this->range_end)
+    {
+        this->exhausted = true;
+        return;
+    }
+
+    // Extent runs until next hole or end of range
+    off_t hole = sys::file::seek
+    (
+        this->file_descriptor,
+        data,
+        SEEK_HOLE
+    );
+    size_type bound = (hole == mmap::INTERNAL_ERROR_CODE)
+        ? this->range_end
+        : std::min<size_type>(hole, this->range_end);
+
+    // Round outward to whole units relative to range
+    const size_type first = (data - this->range_begin) / this->unit_size;
+    const size_type last  = (bound - this->range_begin + this->unit_size - 1) / this->unit_size;
+
+    this->current  = {first, last - first};
+    this->position = this->range_begin + last * this->unit_size;
+}
+
+
+mmap::extent_range::extent_range
+(
+    const sys::file::descriptor file_descriptor,
+    const size_type             range_begin,
+    const size_type             range_end,
+    const size_type             unit_size
+) noexcept
+{
+    this->file_descriptor = file_descriptor;
+    this->range_begin     = range_begin;
+    this->range_end       = range_end;
+    this->unit_size       = unit_size;
+}
+
+mmap::extent_iterator
+mmap::extent_range::begin() const noexcept
+{
+    return extent_iterator
+    (
+        this->file_descriptor,
+        this->range_begin,
+        this->range_end,
+        this->unit_size
+    );
+}
+
+mmap::extent_iterator
+mmap::extent_range::end() const noexcept
+{
+    return extent_iterator
+    (
+        this->file_descriptor,
+        this->range_end,
+        this->range_end,
+        this->unit_size
+    );
+}
+
+
+mmap::extent_range
+mmap::extents
+(
+    const file &mapping
+) noexcept
+{
+    return extent_range
+    (
+        mapping.descriptor(),
+        mapping.offset(),
+        mapping.offset() + mapping.capacity(),
+        1
+    );
+}
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <iterator>
+
+#include "file/file.hpp"
+#include "file/ordered_file.hpp"
+
+
+namespace mmap
+{
+
+// Range of a mapping backed by allocated data, in units of the mapping
+struct extent
+{
+    size_type offset;
+    size_type length;
+};
+
+// Forward iterator over data extents, skipping holes via SEEK_DATA/SEEK_HOLE
+class extent_iterator
+{
+private:
+    sys::file::descriptor file_descriptor;
+    size_type             range_begin;
+    size_type             range_end;
+    size_type             unit_size;
+
+    size_type             position;
+    extent                current;
+    bool                  exhausted;
+
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type        = extent;
+    using difference_type   = std::ptrdiff_t;
+    using pointer           = const extent *;
+    using reference         = const extent &;
+
+    extent_iterator
+    (
+        const sys::file::descriptor file_descriptor,
+        const size_type             range_begin,
+        const size_type             range_end,
+        const size_type             unit_size
+    ) noexcept;
+
+    reference
+    operator*() const noexcept;
+    pointer
+    operator->() const noexcept;
+
+    extent_iterator &
+    operator++() noexcept;
+    extent_iterator
+    operator++(int) noexcept;
+
+    bool
+    operator==
+    (
+        const extent_iterator &other
+    ) const noexcept;
+    bool
+    operator!=
+    (
+        const extent_iterator &other
+    ) const noexcept;
+
+private:
+    void
+    advance() noexcept;
+};
+
+class extent_range
+{
+private:
+    sys::file::descriptor file_descriptor;
+    size_type             range_begin;
+    size_type             range_end;
+    size_type             unit_size;
+
+public:
+    extent_range
+    (
+        const sys::file::descriptor file_descriptor,
+        const size_type             range_begin,
+        const size_type             range_end,
+        const size_type             unit_size
+    ) noexcept;
+
+    extent_iterator
+    begin() const noexcept;
+    extent_iterator
+    end() const noexcept;
+};
+
+// Data extents of a mapping in bytes
+extent_range
+extents
+(
+    const file &mapping
+) noexcept;
+
+// Data extents of an ordered mapping in elements
+template <typename data_type>
+extent_range
+extents
+(
+    const ordered_file<data_type> &mapping
+) noexcept
+{
+    return extent_range
+    (
+        mapping.descriptor(),
+        mapping.offset(),
+        mapping.offset() + mapping.capacity(),
+        sizeof(data_type)
+    );
+}
+
+} // mmap namespace
@@ -1,3 +1,5 @@
+#include <algorithm>
+#include <cerrno>
 #include <exception>
 #include <filesystem>
 #include <ios>
@@ -8,6 +10,7 @@
 #include <util/record.hpp>
 
 #include "file.hpp"
+#include "numa.hpp"
 
 
 mmap::file::file
@@ -26,7 +29,8 @@ mmap::file::file
     const sys::memory::flag_code  protocol_flag,
     const sys::memory::flag_code  mapping_flag,
     const sys::memory::flag_code  sync_flag,
-    const sys::memory::flag_code  remap_flag
+    const sys::memory::flag_code  remap_flag,
+    const sys::file::flag_code    allocate_flag
 )
 {
     // Validate file path
@@ -49,6 +53,10 @@ mmap::file::file
     this->file_offset_bytes   = file_offset_bytes;
     this->base_address        = base_address;
 
+    // internal metadata
+    this->file_address    = nullptr;
+    this->file_descriptor = mmap::INTERNAL_ERROR_CODE;
+
     // flags
     this->open_flag     = open_flag;
     this->lock_flag     = lock_flag;
@@ -56,10 +64,12 @@ mmap::file::file
     this->mapping_flag  = mapping_flag;
     this->sync_flag     = sync_flag;
     this->remap_flag    = remap_flag;
+    this->allocate_flag = allocate_flag;
 }
 
 mmap::file::~file() noexcept
 {
+    this->wait();
     if (this->file_address)
         this->close();
 }
@@ -117,7 +127,8 @@ mmap::file::open_and_map
     sys::file::descriptor file_descriptor = sys::file::open
     (
         this->file_path.c_str(), 
-        open_flag
+        open_flag,
+        mmap::CREATE_MODE
     );
     if (file_descriptor == mmap::INTERNAL_ERROR_CODE)
     {
@@ -145,6 +156,8 @@ mmap::file::open_and_map
             util::log::type::ERROR
         );
 
+        sys::file::close(this->file_descriptor);
+        this->file_descriptor = mmap::INTERNAL_ERROR_CODE;
         return nullptr;
     }
 
@@ -152,7 +165,7 @@ mmap::file::open_and_map
     sys::file::status_code resize_status = sys::file::resize
     (
         this->file_descriptor,
-        this->file_capacity_bytes
+        this->file_offset_bytes + this->file_capacity_bytes
     );
     if (resize_status == mmap::INTERNAL_ERROR_CODE)
     {
@@ -165,6 +178,19 @@ mmap::file::open_and_map
         return nullptr;
     }
 
+    // Reserve blocks up front so writes cannot fault on a full device
+    if (this->allocate_flag != mmap::NO_ALLOCATE)
+    {
+        mmap::status_code allocate_status = mmap::file::preallocate
+        (
+            0,
+            this->file_capacity_bytes,
+            this->allocate_flag
+        );
+        if (allocate_status == mmap::EXTERNAL_ERROR_CODE)
+            return nullptr;
+    }
+
     // Map file
     address_type file_address = sys::memory::map
     (
@@ -175,7 +201,7 @@ mmap::file::open_and_map
         this->file_descriptor, 
         this->file_offset_bytes
     );
-    if (file_address == nullptr)
+    if (file_address == MAP_FAILED)
     {
         util::log::record
         (
@@ -191,6 +217,459 @@ mmap::file::open_and_map
 }
 
 
+mmap::address_type
+mmap::file::open_and_populate
+(
+    const size_type thread_count,
+    const bool      background
+) noexcept
+{
+    // Map file
+    address_type file_address = this->open();
+    if (file_address == nullptr)
+        return nullptr;
+
+    // Prefault mapping
+    mmap::status_code populate_status = this->populate
+    (
+        thread_count,
+        background
+    );
+    if (populate_status == mmap::EXTERNAL_ERROR_CODE)
+    {
+        util::log::record
+        (
+            "Unable to prefault mapping; pages will fault on first access",
+            util::log::type::FLAG
+        );
+    }
+
+    return file_address;
+}
+
+mmap::status_code
+mmap::file::populate
+(
+    const size_type thread_count,
+    const bool      background
+) noexcept
+{
+    // Check if mapped
+    if (!this->file_address)
+    {
+        util::log::record
+        (
+            "Memory is not yet mapped",
+            util::log::type::ERROR
+        );
+
+        return mmap::EXTERNAL_ERROR_CODE;
+    }
+
+    // Only one population may run at a time
+    mmap::status_code wait_status = this->wait();
+    if (wait_status == mmap::EXTERNAL_ERROR_CODE)
+        return mmap::EXTERNAL_ERROR_CODE;
+
+    // Private writable mappings are populated writable to skip later copy
+    // faults; shared ones are read so the whole file is not marked dirty
+    sys::memory::flag_code advice = (this->protocol_flag & PROT_WRITE)
+        && !(this->mapping_flag & MAP_SHARED)
+        ? MADV_POPULATE_WRITE
+        : MADV_POPULATE_READ;
+
+    // Chunks are handed out in address order so the front fills first
+    const size_type chunk_size_bytes = mmap::POPULATE_CHUNK_BYTES;
+    const size_type chunk_count
+        = (this->file_capacity_bytes + chunk_size_bytes - 1) / chunk_size_bytes;
+    const size_type worker_count
+        = std::max<size_type>(1, std::min(thread_count, chunk_count));
+
+    this->populate_cursor = 0;
+    this->populate_failed = false;
+
+    try
+    {
+        for (size_type worker = 0; worker < worker_count; ++worker)
+        {
+            this->populate_threads.emplace_back
+            (
+                &mmap::file::populate_worker,
+                this,
+                chunk_count,
+                chunk_size_bytes,
+                advice
+            );
+        }
+    }
+
+    catch (const std::exception &exception)
+    {
+        util::log::record
+        (
+            "Unable to start all prefault workers",
+            util::log::type::FLAG
+        );
+
+        // Remaining chunks are drained by the workers already running
+        if (this->populate_threads.empty())
+            return mmap::EXTERNAL_ERROR_CODE;
+    }
+
+    if (background)
+        return mmap::GLOBAL_SUCCESS_CODE;
+
+    return this->wait();
+}
+
+mmap::status_code
+mmap::file::wait() noexcept
+{
+    for (std::thread &thread: this->populate_threads)
+    {
+        if (thread.joinable())
+            thread.join();
+    }
+    this->populate_threads.clear();
+
+    // Failure is reported once; later populations start clean
+    if (this->populate_failed.exchange(false))
+    {
+        util::log::record
+        (
+            "Unable to prefault all pages of mapping",
+            util::log::type::ERROR
+        );
+
+        return mmap::EXTERNAL_ERROR_CODE;
+    }
+
+    return mmap::GLOBAL_SUCCESS_CODE;
+}
+
+mmap::status_code
+mmap::file::lock_range
+(
+    const size_type  offset,
+    const size_type  length,
+    const short      lock_type,
+    const bool       blocking
+) noexcept
+{
+    // Check if opened
+    if (this->file_descriptor == mmap::INTERNAL_ERROR_CODE)
+    {
+        util::log::record
+        (
+            "File is not yet opened",
+            util::log::type::ERROR
+        );
+
+        return mmap::EXTERNAL_ERROR_CODE;
+    }
+
+    // Open file description locks belong to this descriptor, not process
+    struct flock range = {};
+    range.l_type   = lock_type;
+    range.l_whence = SEEK_SET;
+    range.l_start  = this->file_offset_bytes + offset;
+    range.l_len    = length;
+
+    sys::file::status_code lock_status;
+    do
+    {
+        lock_status = sys::file::control
+        (
+            this->file_descriptor,
+            blocking ? F_OFD_SETLKW : F_OFD_SETLK,
+            &range
+        );
+    }
+    while (lock_status == mmap::INTERNAL_ERROR_CODE && errno == EINTR);
+
+    if (lock_status == mmap::INTERNAL_ERROR_CODE)
+    {
+        // Held by another description
+        if (!blocking && (errno == EAGAIN || errno == EACCES))
+            return mmap::CONTENDED_CODE;
+
+        std::stringstream stream;
+        stream << "Unable to " << (lock_type == F_UNLCK ? "release" : "place")
+            << " lock on file bytes " << range.l_start << " to "
+            << range.l_start + range.l_len;
+
+        util::log::record
+        (
+            stream.str(),
+            util::log::type::ERROR
+        );
+
+        return mmap::EXTERNAL_ERROR_CODE;
+    }
+
+    return mmap::GLOBAL_SUCCESS_CODE;
+}
+
+void
+mmap::file::populate_worker
+(
+    const size_type        chunk_count,
+    const size_type        chunk_size_bytes,
+    sys::memory::flag_code advice
+) noexcept
+{
+    std::uint8_t *base = static_cast<std::uint8_t *>(this->file_address);
+    for (;;)
+    {
+        const size_type chunk = this->populate_cursor.fetch_add(1);
+        if (chunk >= chunk_count)
+            return;
+
+        const size_type start  = chunk * chunk_size_bytes;
+        const size_type length = std::min
+        (
+            chunk_size_bytes,
+            this->file_capacity_bytes - start
+        );
+
+        sys::memory::status_code advise_status = sys::memory::advise
+        (
+            base + start,
+            length,
+            advice
+        );
+        if (advise_status != mmap::INTERNAL_ERROR_CODE)
+            continue;
+
+        // Kernels before 5.14 lack populate advice; fault pages by touch
+        if (errno != EINVAL)
+        {
+            this->populate_failed = true;
+            continue;
+        }
+
+        const size_type page_size = sys::memory::page_size;
+        for (size_type page = 0; page < length; page += page_size)
+            static_cast<void>(*static_cast<volatile std::uint8_t *>(base + start + page));
+    }
+}
+
+mmap::status_code
+mmap::file::place
+(
+    const placement policy,
+    const node_type node
+) noexcept
+{
+    // Check if mapped
+    if (!this->file_address)
+    {
+        util::log::record
+        (
+            "Memory is not yet mapped",
+            util::log::type::ERROR
+        );
+
+        return mmap::EXTERNAL_ERROR_CODE;
+    }
+
+    // Shared page cache ignores the mapping's policy; fault pages in place
+    return mmap::numa::place
+    (
+        this->file_address,
+        this->file_capacity_bytes,
+        policy,
+        node,
+        (this->mapping_flag & MAP_SHARED) && (this->protocol_flag & PROT_READ)
+    );
+}
+
+mmap::status_code
+mmap::file::preallocate
+(
+    const size_type             offset,
+    const size_type             length,
+    const sys::file::flag_code  allocate_flag
+) noexcept
+{
+    // Check if opened
+    if (this->file_descriptor == mmap::INTERNAL_ERROR_CODE)
+    {
+        util::log::record
+        (
+            "File is not yet opened",
+            util::log::type::ERROR
+        );
+
+        return mmap::EXTERNAL_ERROR_CODE;
+    }
+
+    // Empty ranges are rejected by fallocate
+    if (length == 0)
+        return mmap::GLOBAL_SUCCESS_CODE;
+
+    // Allocate blocks for range
+    sys::file::status_code allocate_status = sys::file::allocate
+    (
+        this->file_descriptor,
+        allocate_flag,
+        this->file_offset_bytes + offset,
+        length
+    );
+    if (allocate_status == mmap::INTERNAL_ERROR_CODE)
+    {
+        // Filesystems without extents keep the file sparse
+        if (errno == EOPNOTSUPP)
+        {
+            util::log::record
+            (
+                "File system does not support preallocation; "
+                "file remains sparse",
+                util::log::type::FLAG
+            );
+
+            return mmap::GLOBAL_SUCCESS_CODE;
+        }
+
+        util::log::record
+        (
+            "Unable to preallocate storage for file",
+            util::log::type::ERROR
+        );
+
+        return mmap::EXTERNAL_ERROR_CODE;
+    }
+
+    return mmap::GLOBAL_SUCCESS_CODE;
+}
+
+mmap::status_code
+mmap::file::discard
+(
+    const size_type offset,
+    const size_type length
+) noexcept
+{
+    // Check if mapped
+    if (!this->file_address)
+    {
+        util::log::record
+        (
+            "Memory is not yet mapped",
+            util::log::type::ERROR
+        );
+
+        return mmap::EXTERNAL_ERROR_CODE;
+    }
+
+    // Check range lies within mapping
+    if (offset > this->file_capacity_bytes || length > this->file_capacity_bytes - offset)
+    {
+        util::log::record
+        (
+            "Discarded range exceeds mapping",
+            util::log::type::ERROR
+        );
+
+        return mmap::EXTERNAL_ERROR_CODE;
+    }
+
+    // Punch hole, releasing blocks while keeping file length
+    sys::file::status_code punch_status = sys::file::allocate
+    (
+        this->file_descriptor,
+        FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE,
+        this->file_offset_bytes + offset,
+        length
+    );
+    if (punch_status == mmap::INTERNAL_ERROR_CODE)
+    {
+        util::log::record
+        (
+            "Unable to punch hole in file",
+            util::log::type::ERROR
+        );
+
+        return mmap::EXTERNAL_ERROR_CODE;
+    }
+
+    // Drop whole pages of range, including private copies
+    const size_type page_size = sys::memory::page_size;
+    const size_type first     = (offset + page_size - 1) / page_size * page_size;
+    const size_type last      = (offset + length) / page_size * page_size;
+    if (first < last)
+    {
+        sys::memory::status_code advise_status = sys::memory::advise
+        (
+            static_cast<std::uint8_t *>(this->file_address) + first,
+            last - first,
+            MADV_DONTNEED
+        );
+        if (advise_status == mmap::INTERNAL_ERROR_CODE)
+        {
+            util::log::record
+            (
+                "Unable to drop pages of discarded range",
+                util::log::type::ERROR
+            );
+
+            return mmap::EXTERNAL_ERROR_CODE;
+        }
+    }
+
+    return mmap::GLOBAL_SUCCESS_CODE;
+}
+
+mmap::status_code
+mmap::file::lock
+(
+    const size_type  offset,
+    const size_type  length,
+    const range_lock mode
+) noexcept
+{
+    return this->lock_range
+    (
+        offset,
+        length,
+        mode == range_lock::EXCLUSIVE ? F_WRLCK : F_RDLCK,
+        true
+    );
+}
+
+mmap::status_code
+mmap::file::try_lock
+(
+    const size_type  offset,
+    const size_type  length,
+    const range_lock mode
+) noexcept
+{
+    return this->lock_range
+    (
+        offset,
+        length,
+        mode == range_lock::EXCLUSIVE ? F_WRLCK : F_RDLCK,
+        false
+    );
+}
+
+mmap::status_code
+mmap::file::unlock
+(
+    const size_type offset,
+    const size_type length
+) noexcept
+{
+    return this->lock_range
+    (
+        offset,
+        length,
+        F_UNLCK,
+        false
+    );
+}
+
 mmap::status_code
 inline mmap::file::flush() noexcept
 {
@@ -211,7 +690,7 @@ mmap::file::flush
 ) noexcept
 {
     // Check if mapped
-    if (this->file_address)
+    if (!this->file_address)
     {
         util::log::record
         (
@@ -279,8 +758,12 @@ mmap::file::close_and_unmap
     sys::memory::flag_code sync_flag
 ) noexcept
 {
+    // Finish outstanding prefault before any early return; joinable
+    // workers would terminate the process on destruction
+    this->wait();
+
     // Check if mapped
-    if (this->file_address)
+    if (!this->file_address)
     {
         util::log::record
         (
@@ -372,6 +855,8 @@ mmap::file::close_and_unmap
 
         return mmap::EXTERNAL_ERROR_CODE;
     }    
+    this->file_address    = nullptr;
+    this->file_descriptor = mmap::INTERNAL_ERROR_CODE;
 
     return mmap::GLOBAL_SUCCESS_CODE;
 }
@@ -397,8 +882,12 @@ mmap::address_type mmap::file::remap
     const flag_code     remap_flag
 ) noexcept
 {
+    // Finish outstanding prefault before any early return; joinable
+    // workers would terminate the process on destruction
+    this->wait();
+
     // Check if mapped
-    if (this->file_address)
+    if (!this->file_address)
     {
         util::log::record
         (
@@ -409,15 +898,46 @@ mmap::address_type mmap::file::remap
         return nullptr;
     }
 
+    // Resize file
+    sys::file::status_code resize_status = sys::file::resize
+    (
+        this->file_descriptor,
+        this->file_offset_bytes + file_capacity
+    );
+    if (resize_status == mmap::INTERNAL_ERROR_CODE)
+    {
+        util::log::record
+        (
+            "Unable to resize file to provided size",
+            util::log::type::ERROR
+        );
+
+        return nullptr;
+    }
+
+    // Reserve blocks of grown range
+    if (this->allocate_flag != mmap::NO_ALLOCATE && file_capacity > this->file_capacity_bytes)
+    {
+        mmap::status_code allocate_status = mmap::file::preallocate
+        (
+            this->file_capacity_bytes,
+            file_capacity - this->file_capacity_bytes,
+            this->allocate_flag
+        );
+        if (allocate_status == mmap::EXTERNAL_ERROR_CODE)
+            return nullptr;
+    }
+
     // Remap file
     address_type file_address = sys::memory::remap
     (
-        base_address,
+        this->file_address,
         this->file_capacity_bytes, 
         file_capacity,
-        remap_flag
+        remap_flag,
+        base_address
     );
-    if (file_address == nullptr)
+    if (file_address == MAP_FAILED)
     {
         util::log::record
         (
@@ -427,7 +947,8 @@ mmap::address_type mmap::file::remap
 
         return nullptr;
     }
-    this->file_address = file_address;
+    this->file_address        = file_address;
+    this->file_capacity_bytes = file_capacity;
    
     return this->file_address;
 }
@@ -439,9 +960,39 @@ mmap::file::address() const noexcept
     return this->file_address;
 }
 
+mmap::size_type 
+mmap::file::capacity() const noexcept
+{
+    return this->file_capacity_bytes;
+}
+
+mmap::size_type 
+mmap::file::offset() const noexcept
+{
+    return this->file_offset_bytes;
+}
+
+sys::file::descriptor 
+mmap::file::descriptor() const noexcept
+{
+    return this->file_descriptor;
+}
+
+sys::memory::flag_code
+mmap::file::protocol() const noexcept
+{
+    return this->protocol_flag;
+}
+
+sys::memory::flag_code
+mmap::file::mapping() const noexcept
+{
+    return this->mapping_flag;
+}
+
 
 bool 
-inline mmap::file::valid_path
+mmap::file::valid_path
 (
     const std::string &file_path
 ) noexcept
@@ -1,9 +1,12 @@
 #pragma once
 
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
 #include <cstdlib>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include <lib/file.hpp>
 #include <lib/mmap.hpp>
@@ -16,10 +19,34 @@ using address_type = void *;
 using size_type    = std::size_t;
 using status_code  = std::uint8_t;
 using flag_code    = std::uint8_t;
+using node_type    = std::size_t;
 
 constexpr sys::file::sint_t GLOBAL_SUCCESS_CODE = EXIT_SUCCESS;
 constexpr sys::file::sint_t EXTERNAL_ERROR_CODE = EXIT_FAILURE;
 constexpr sys::file::sint_t INTERNAL_ERROR_CODE = -1;
+constexpr sys::file::sint_t CONTENDED_CODE      = 2;
+constexpr sys::file::sint_t TIMEOUT_CODE        = 3;
+
+constexpr sys::file::flag_code NO_ALLOCATE = -1;
+
+constexpr mode_t    CREATE_MODE          = 0666;
+constexpr size_type POPULATE_CHUNK_BYTES = 2 << 20;
+
+// Byte range lock modes
+enum class range_lock: std::uint8_t
+{
+    SHARED    = 0x00,
+    EXCLUSIVE = 0x01
+};
+
+// NUMA placement of mapped pages
+enum class placement: std::uint8_t
+{
+    LOCAL      = 0x00,
+    BIND       = 0x01,
+    INTERLEAVE = 0x02,
+    PARTITION  = 0x04
+};
 
 class file
 {
@@ -48,6 +75,14 @@ protected:
     // Realloction flags
     sys::memory::flag_code remap_flag = MREMAP_MAYMOVE;
 
+    // Preallocation flags
+    sys::file::flag_code   allocate_flag = mmap::NO_ALLOCATE;
+
+    // Prefault workers
+    std::vector<std::thread> populate_threads;
+    std::atomic<size_type>   populate_cursor{0};
+    std::atomic<bool>        populate_failed{false};
+
 public:
     file
     (
@@ -65,7 +100,8 @@ public:
         const sys::memory::flag_code  protocol_flag = PROT_READ | PROT_WRITE,
         const sys::memory::flag_code  mapping_flag  = MAP_SHARED,
         const sys::memory::flag_code  sync_flag     = MS_ASYNC,
-        const sys::memory::flag_code  remap_flag    = MREMAP_MAYMOVE
+        const sys::memory::flag_code  remap_flag    = MREMAP_MAYMOVE,
+        const sys::file::flag_code    allocate_flag = mmap::NO_ALLOCATE
     );
 
     virtual ~file() noexcept;
@@ -76,6 +112,16 @@ public:
 
     address_type 
     address() const noexcept;
+    size_type 
+    capacity() const noexcept;
+    size_type 
+    offset() const noexcept;
+    sys::file::descriptor 
+    descriptor() const noexcept;
+    sys::memory::flag_code
+    protocol() const noexcept;
+    sys::memory::flag_code
+    mapping() const noexcept;
 
     address_type 
     virtual open() noexcept;
@@ -87,6 +133,64 @@ public:
         sys::memory::flag_code protocol_flag,
         sys::memory::flag_code mapping_flag
     ) noexcept;     
+    address_type 
+    virtual open_and_populate
+    (
+        const size_type thread_count,
+        const bool      background = false
+    ) noexcept;
+
+    status_code
+    virtual populate
+    (
+        const size_type thread_count,
+        const bool      background = false
+    ) noexcept;
+    status_code
+    virtual wait() noexcept;
+
+    // Shared mappings are faulted in under the policy; see numa::place
+    status_code
+    virtual place
+    (
+        const placement policy,
+        const node_type node = 0
+    ) noexcept;
+
+    status_code
+    virtual preallocate
+    (
+        const size_type             offset,
+        const size_type             length,
+        const sys::file::flag_code  allocate_flag
+    ) noexcept;
+    status_code
+    virtual discard
+    (
+        const size_type offset,
+        const size_type length
+    ) noexcept;
+
+    status_code
+    virtual lock
+    (
+        const size_type  offset,
+        const size_type  length,
+        const range_lock mode = range_lock::EXCLUSIVE
+    ) noexcept;
+    status_code
+    virtual try_lock
+    (
+        const size_type  offset,
+        const size_type  length,
+        const range_lock mode = range_lock::EXCLUSIVE
+    ) noexcept;
+    status_code
+    virtual unlock
+    (
+        const size_type  offset,
+        const size_type  length
+    ) noexcept;
 
     status_code
     virtual flush() noexcept;
@@ -119,12 +223,29 @@ public:
         const flag_code    remap_flag
     ) noexcept;
     
-protected:
-    inline static bool valid_path
+    static bool valid_path
     (
         const std::string &file_path
     ) noexcept;
 
+protected:
+    status_code
+    lock_range
+    (
+        const size_type  offset,
+        const size_type  length,
+        const short      lock_type,
+        const bool       blocking
+    ) noexcept;
+
+    void 
+    populate_worker
+    (
+        const size_type        chunk_count,
+        const size_type        chunk_size_bytes,
+        sys::memory::flag_code advice
+    ) noexcept;
+
 };
 
 } // mmap namespace
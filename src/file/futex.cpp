@@ -0,0 +1,241 @@
+#include <cerrno>
+#include <climits>
+
+#include <lib/futex.hpp>
+
+#include <util/record.hpp>
+
+#include "futex.hpp"
+
+
+namespace
+{
+
+using mmap::futex::duration_type;
+
+std::uint32_t *
+word_address
+(
+    const std::atomic<std::uint32_t> &word
+) noexcept
+{
+    return reinterpret_cast<std::uint32_t *>(const_cast<std::atomic<std::uint32_t> *>(&word));
+}
+
+// Sleep while word still holds expected; early returns are fine
+mmap::status_code
+block
+(
+    std::atomic<std::uint32_t> &word,
+    const std::uint32_t         expected,
+    const duration_type         timeout
+) noexcept
+{
+    struct timespec  interval;
+    struct timespec *limit = nullptr;
+    if (timeout != mmap::futex::FOREVER)
+    {
+        const auto seconds = std::chrono::duration_cast<std::chrono::seconds>(timeout);
+        interval.tv_sec  = seconds.count();
+        interval.tv_nsec = (timeout - seconds).count();
+        limit            = &interval;
+    }
+
+    sys::futex::status_code wait_status = sys::futex::wait(word_address(word), expected, limit);
+    if (wait_status == mmap::INTERNAL_ERROR_CODE)
+    {
+        // Value already moved on, or a signal arrived
+        if (errno == EAGAIN || errno == EINTR)
+            return mmap::GLOBAL_SUCCESS_CODE;
+
+        if (errno == ETIMEDOUT)
+            return mmap::TIMEOUT_CODE;
+
+        util::log::record
+        (
+            "Unable to wait on shared futex",
+            util::log::type::ERROR
+        );
+
+        return mmap::EXTERNAL_ERROR_CODE;
+    }
+
+    return mmap::GLOBAL_SUCCESS_CODE;
+}
+
+// Wake sleepers only when some are registered; waiters bump the count
+// before sleeping and wakers read it after publishing, so one always sees
+// the other
+void
+wake
+(
+    std::atomic<std::uint32_t>       &word,
+    const std::atomic<std::uint32_t> &waiters,
+    const sys::futex::count_type      count
+) noexcept
+{
+    if (waiters.load(std::memory_order_seq_cst))
+        sys::futex::wake(word_address(word), count);
+}
+
+// Block until done(word) holds or timeout passes
+template <typename done_type>
+mmap::status_code
+await
+(
+    std::atomic<std::uint32_t> &word,
+    std::atomic<std::uint32_t> &waiters,
+    done_type                 &&done,
+    const duration_type         timeout
+) noexcept
+{
+    const auto start = std::chrono::steady_clock::now();
+    for (;;)
+    {
+        const std::uint32_t value = word.load(std::memory_order_acquire);
+        if (done(value))
+            return mmap::GLOBAL_SUCCESS_CODE;
+
+        duration_type remaining = mmap::futex::FOREVER;
+        if (timeout != mmap::futex::FOREVER)
+        {
+            const duration_type elapsed = std::chrono::steady_clock::now() - start;
+            if (elapsed >= timeout)
+                return mmap::TIMEOUT_CODE;
+            remaining = timeout - elapsed;
+        }
+
+        waiters.fetch_add(1, std::memory_order_seq_cst);
+        mmap::status_code block_status = block(word, value, remaining);
+        waiters.fetch_sub(1, std::memory_order_relaxed);
+
+        if (block_status == mmap::EXTERNAL_ERROR_CODE)
+            return mmap::EXTERNAL_ERROR_CODE;
+    }
+}
+
+} // anonymous namespace
+
+
+void
+mmap::futex::event::set() noexcept
+{
+    if (this->state.exchange(1, std::memory_order_seq_cst) == 0)
+        wake(this->state, this->waiters, INT_MAX);
+}
+
+void
+mmap::futex::event::reset() noexcept
+{
+    this->state.store(0, std::memory_order_release);
+}
+
+bool
+mmap::futex::event::is_set() const noexcept
+{
+    return this->state.load(std::memory_order_acquire) != 0;
+}
+
+mmap::status_code
+mmap::futex::event::wait
+(
+    const duration_type timeout
+) noexcept
+{
+    return await
+    (
+        this->state,
+        this->waiters,
+        [](const std::uint32_t state) { return state != 0; },
+        timeout
+    );
+}
+
+
+std::uint32_t
+mmap::futex::condition::prepare() const noexcept
+{
+    return this->generation.load(std::memory_order_acquire);
+}
+
+mmap::status_code
+mmap::futex::condition::wait
+(
+    const std::uint32_t generation,
+    const duration_type timeout
+) noexcept
+{
+    this->waiters.fetch_add(1, std::memory_order_seq_cst);
+    mmap::status_code block_status = block(this->generation, generation, timeout);
+    this->waiters.fetch_sub(1, std::memory_order_relaxed);
+
+    return block_status;
+}
+
+void
+mmap::futex::condition::notify_one() noexcept
+{
+    this->generation.fetch_add(1, std::memory_order_seq_cst);
+    wake(this->generation, this->waiters, 1);
+}
+
+void
+mmap::futex::condition::notify_all() noexcept
+{
+    this->generation.fetch_add(1, std::memory_order_seq_cst);
+    wake(this->generation, this->waiters, INT_MAX);
+}
+
+
+void
+mmap::futex::latch::reset
+(
+    const std::uint32_t count
+) noexcept
+{
+    this->remaining.store(count, std::memory_order_release);
+}
+
+void
+mmap::futex::latch::count_down
+(
+    const std::uint32_t count
+) noexcept
+{
+    // Clamp at zero so surplus arrivals cannot wrap the count
+    std::uint32_t current = this->remaining.load(std::memory_order_relaxed);
+    std::uint32_t next;
+    do
+    {
+        if (current == 0)
+            return;
+
+        next = count >= current ? 0 : current - count;
+    }
+    while (!this->remaining.compare_exchange_weak(current, next, std::memory_order_seq_cst));
+
+    // Last arrival releases everyone
+    if (next == 0)
+        wake(this->remaining, this->waiters, INT_MAX);
+}
+
+bool
+mmap::futex::latch::try_wait() const noexcept
+{
+    return this->remaining.load(std::memory_order_acquire) == 0;
+}
+
+mmap::status_code
+mmap::futex::latch::wait
+(
+    const duration_type timeout
+) noexcept
+{
+    return await
+    (
+        this->remaining,
+        this->waiters,
+        [](const std::uint32_t remaining) { return remaining == 0; },
+        timeout
+    );
+}
@@ -0,0 +1,125 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <type_traits>
+
+#include "file/file.hpp"
+
+
+namespace mmap
+{
+
+// Wait/notify primitives whose state lives inside a shared mapping; every
+// process mapping the same bytes can block on and wake the others. Zeroed
+// memory is a valid initial state, so they can be cast over a fresh file.
+// A process dying mid-wait leaves its waiter count raised, which only
+// costs later notifies a spare system call.
+namespace futex
+{
+
+using duration_type = std::chrono::nanoseconds;
+
+// Wait without limit
+constexpr duration_type FOREVER = duration_type::max();
+
+// Manual reset flag
+struct event
+{
+    std::atomic<std::uint32_t> state;
+    std::atomic<std::uint32_t> waiters;
+
+    void
+    set() noexcept;
+    void
+    reset() noexcept;
+    bool
+    is_set() const noexcept;
+
+    // Success once set, TIMEOUT_CODE if still clear after timeout
+    status_code
+    wait
+    (
+        const duration_type timeout = FOREVER
+    ) noexcept;
+};
+
+// Condition-style waiters: read the generation, check shared state, then
+// wait on that generation so a notify in between is never lost
+struct condition
+{
+    std::atomic<std::uint32_t> generation;
+    std::atomic<std::uint32_t> waiters;
+
+    std::uint32_t
+    prepare() const noexcept;
+
+    // May return early; callers recheck their state
+    status_code
+    wait
+    (
+        const std::uint32_t generation,
+        const duration_type timeout = FOREVER
+    ) noexcept;
+
+    // Wait until predicate holds
+    template <typename predicate_type>
+    status_code
+    wait_for
+    (
+        predicate_type      &&predicate,
+        const duration_type   timeout = FOREVER
+    ) noexcept;
+
+    void
+    notify_one() noexcept;
+    void
+    notify_all() noexcept;
+};
+
+// Countdown latch; reset only while nobody waits on it. Counting down
+// past zero stops at zero
+struct latch
+{
+    std::atomic<std::uint32_t> remaining;
+    std::atomic<std::uint32_t> waiters;
+
+    void
+    reset
+    (
+        const std::uint32_t count
+    ) noexcept;
+    void
+    count_down
+    (
+        const std::uint32_t count = 1
+    ) noexcept;
+    bool
+    try_wait() const noexcept;
+
+    status_code
+    wait
+    (
+        const duration_type timeout = FOREVER
+    ) noexcept;
+};
+
+static_assert
+(
+    std::atomic<std::uint32_t>::is_always_lock_free
+        && sizeof(std::atomic<std::uint32_t>) == sizeof(std::uint32_t),
+    "Futex words must be plain 32-bit words"
+);
+static_assert
+(
+    std::is_standard_layout<event>::value && std::is_standard_layout<condition>::value
+        && std::is_standard_layout<latch>::value,
+    "Futex primitives are placed directly in shared memory"
+);
+
+} // futex namespace
+
+} // mmap namespace
+
+#include "file/futex.tpp"
@@ -0,0 +1,30 @@
+template <typename predicate_type>
+mmap::status_code
+mmap::futex::condition::wait_for
+(
+    predicate_type      &&predicate,
+    const duration_type   timeout
+) noexcept
+{
+    const auto start = std::chrono::steady_clock::now();
+    for (;;)
+    {
+        // Generation first, so a notify after the check wakes us
+        const std::uint32_t generation = this->prepare();
+        if (predicate())
+            return mmap::GLOBAL_SUCCESS_CODE;
+
+        duration_type remaining = FOREVER;
+        if (timeout != FOREVER)
+        {
+            const duration_type elapsed = std::chrono::steady_clock::now() - start;
+            if (elapsed >= timeout)
+                return mmap::TIMEOUT_CODE;
+            remaining = timeout - elapsed;
+        }
+
+        mmap::status_code wait_status = this->wait(generation, remaining);
+        if (wait_status == mmap::EXTERNAL_ERROR_CODE)
+            return mmap::EXTERNAL_ERROR_CODE;
+    }
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+#include "file/file.hpp"
+
+
+namespace mmap
+{
+
+// Self-describing layout stored in the first page of a described file
+struct file_header
+{
+    std::uint64_t magic;
+    std::uint32_t version;
+    std::uint32_t element_size;
+    std::uint64_t type_hash;
+    std::uint64_t element_count;
+    std::uint64_t capacity;
+    std::uint64_t data_offset;
+};
+
+constexpr std::uint64_t HEADER_MAGIC   = 0x50414d4d454c4946;  // "FILEMMAP"
+constexpr std::uint32_t HEADER_VERSION = 1;
+
+// Stable per-type hash of the compiler's spelling of the type name
+template <typename data_type>
+std::uint64_t
+type_hash() noexcept
+{
+    // FNV-1a
+    const char   *name = __PRETTY_FUNCTION__;
+    std::uint64_t hash = 0xcbf29ce484222325;
+    for (std::size_t index = 0; index < std::strlen(name); ++index)
+    {
+        hash ^= static_cast<std::uint8_t>(name[index]);
+        hash *= 0x100000001b3;
+    }
+
+    return hash;
+}
+
+} // mmap namespace
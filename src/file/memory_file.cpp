@@ -0,0 +1,504 @@
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#include <lib/socket.hpp>
+#include <util/record.hpp>
+
+#include "memory_file.hpp"
+
+
+// Seal predates some libc headers
+#ifndef F_SEAL_FUTURE_WRITE
+#define F_SEAL_FUTURE_WRITE 0x0010
+#endif
+
+
+namespace
+{
+
+// Default huge page size; huge files are sized in whole huge pages
+constexpr mmap::size_type HUGE_PAGE_BYTES = 2 << 20;
+
+// Payload sent alongside the descriptor; some kernels drop empty messages
+constexpr char DESCRIPTOR_TOKEN = 'F';
+
+} // anonymous namespace
+
+
+mmap::memory_file::memory_file
+(
+    // Required parameters
+    const std::string            &file_name,
+    const size_type               file_size,
+
+    // Advanced parameters
+    const bool                    huge_flag,
+
+    // System call flags
+    const sys::memory::flag_code  protocol_flag
+)
+{
+    // metadata
+    this->file_name           = file_name;
+    this->file_capacity_bytes = file_size;
+    this->file_address        = nullptr;
+    this->file_descriptor     = mmap::INTERNAL_ERROR_CODE;
+
+    // flags
+    this->protocol_flag = protocol_flag;
+
+    // Huge page backing first when asked
+    if (huge_flag)
+    {
+        const size_type huge_size = (file_size + HUGE_PAGE_BYTES - 1)
+            / HUGE_PAGE_BYTES * HUGE_PAGE_BYTES;
+
+        this->file_descriptor = sys::memory::create
+        (
+            this->file_name.c_str(),
+            MFD_CLOEXEC | MFD_ALLOW_SEALING | MFD_HUGETLB
+        );
+        if (this->file_descriptor != mmap::INTERNAL_ERROR_CODE)
+        {
+            this->file_capacity_bytes = huge_size;
+            if (sys::file::resize(this->file_descriptor, huge_size) == mmap::INTERNAL_ERROR_CODE
+                || !this->map(protocol_flag))
+            {
+                sys::file::close(this->file_descriptor);
+                this->file_descriptor     = mmap::INTERNAL_ERROR_CODE;
+                this->file_capacity_bytes = file_size;
+            }
+        }
+
+        if (this->file_descriptor == mmap::INTERNAL_ERROR_CODE)
+        {
+            util::log::record
+            (
+                "Unable to back memory file with huge pages; using base pages",
+                util::log::type::FLAG
+            );
+        }
+    }
+
+    // Base pages
+    if (this->file_descriptor == mmap::INTERNAL_ERROR_CODE)
+    {
+        this->file_descriptor = sys::memory::create
+        (
+            this->file_name.c_str(),
+            MFD_CLOEXEC | MFD_ALLOW_SEALING
+        );
+        if (this->file_descriptor == mmap::INTERNAL_ERROR_CODE)
+        {
+            util::log::record
+            (
+                "Unable to create anonymous memory file",
+                util::log::type::ABORT
+            );
+
+            throw std::runtime_error("Memory file could not be created");
+        }
+
+        if (sys::file::resize(this->file_descriptor, this->file_capacity_bytes) == mmap::INTERNAL_ERROR_CODE)
+        {
+            util::log::record
+            (
+                "Unable to size anonymous memory file",
+                util::log::type::ABORT
+            );
+
+            sys::file::close(this->file_descriptor);
+            throw std::runtime_error("Memory file could not be sized");
+        }
+
+        if (this->file_capacity_bytes && !this->map(protocol_flag))
+        {
+            util::log::record
+            (
+                "Unable to allocate a mapping from a file address to memory file",
+                util::log::type::ABORT
+            );
+
+            sys::file::close(this->file_descriptor);
+            throw std::runtime_error("Memory file could not be mapped");
+        }
+    }
+}
+
+mmap::memory_file::memory_file
+(
+    // Required parameters
+    const sys::file::descriptor   file_descriptor,
+
+    // System call flags
+    const sys::memory::flag_code  protocol_flag
+)
+{
+    // metadata
+    this->file_name           = "received";
+    this->file_capacity_bytes = 0;
+    this->file_address        = nullptr;
+    this->file_descriptor     = file_descriptor;
+
+    // flags
+    this->protocol_flag = protocol_flag;
+
+    // Size mapping from file
+    struct stat file_status;
+    if (sys::file::status(file_descriptor, &file_status) == mmap::INTERNAL_ERROR_CODE)
+    {
+        util::log::record
+        (
+            "Unable to read memory file status",
+            util::log::type::ABORT
+        );
+
+        sys::file::close(file_descriptor);
+        throw std::runtime_error("Provided descriptor size could not be read");
+    }
+    this->file_capacity_bytes = file_status.st_size;
+
+    // Writable shared mappings of write sealed files are refused by kernel
+    const sys::file::flag_code seal_flag = this->seals();
+    if ((protocol_flag & PROT_WRITE) && seal_flag != mmap::INTERNAL_ERROR_CODE
+        && (seal_flag & (F_SEAL_WRITE | F_SEAL_FUTURE_WRITE)))
+    {
+        util::log::record
+        (
+            "Memory file is write sealed; mapping read only",
+            util::log::type::FLAG
+        );
+
+        this->protocol_flag &= ~PROT_WRITE;
+    }
+
+    if (this->file_capacity_bytes && !this->map(this->protocol_flag))
+    {
+        util::log::record
+        (
+            "Unable to allocate a mapping from a file address to memory file",
+            util::log::type::ABORT
+        );
+
+        sys::file::close(file_descriptor);
+        throw std::runtime_error("Provided descriptor could not be mapped");
+    }
+}
+
+mmap::memory_file::~memory_file() noexcept
+{
+    if (this->file_address)
+    {
+        sys::memory::status_code unmap_status = sys::memory::unmap
+        (
+            this->file_address,
+            this->file_capacity_bytes
+        );
+        if (unmap_status == mmap::INTERNAL_ERROR_CODE)
+        {
+            util::log::record
+            (
+                "Unable to unmap memory file from file address",
+                util::log::type::ERROR
+            );
+        }
+    }
+
+    if (this->file_descriptor != mmap::INTERNAL_ERROR_CODE)
+        sys::file::close(this->file_descriptor);
+}
+
+
+mmap::address_type
+mmap::memory_file::address() const noexcept
+{
+    return this->file_address;
+}
+
+mmap::size_type
+mmap::memory_file::capacity() const noexcept
+{
+    return this->file_capacity_bytes;
+}
+
+sys::file::descriptor
+mmap::memory_file::descriptor() const noexcept
+{
+    return this->file_descriptor;
+}
+
+
+mmap::status_code
+mmap::memory_file::resize
+(
+    const size_type file_size
+) noexcept
+{
+    // Grow and shrink seals make kernel refuse
+    if (sys::file::resize(this->file_descriptor, file_size) == mmap::INTERNAL_ERROR_CODE)
+    {
+        util::log::record
+        (
+            "Unable to resize memory file; it may be sealed",
+            util::log::type::ERROR
+        );
+
+        return mmap::EXTERNAL_ERROR_CODE;
+    }
+
+    // Empty mappings are created rather than moved
+    if (!this->file_address)
+    {
+        this->file_capacity_bytes = file_size;
+        if (file_size && !this->map(this->protocol_flag))
+            return mmap::EXTERNAL_ERROR_CODE;
+
+        return mmap::GLOBAL_SUCCESS_CODE;
+    }
+
+    // Mappings cannot be moved to zero length; drop them instead
+    if (!file_size)
+    {
+        if (sys::memory::unmap(this->file_address, this->file_capacity_bytes) == mmap::INTERNAL_ERROR_CODE)
+        {
+            util::log::record
+            (
+                "Unable to unmap memory file from file address",
+                util::log::type::ERROR
+            );
+
+            return mmap::EXTERNAL_ERROR_CODE;
+        }
+        this->file_address        = nullptr;
+        this->file_capacity_bytes = 0;
+
+        return mmap::GLOBAL_SUCCESS_CODE;
+    }
+
+    address_type file_address = sys::memory::remap
+    (
+        this->file_address,
+        this->file_capacity_bytes,
+        file_size,
+        MREMAP_MAYMOVE
+    );
+    if (file_address == MAP_FAILED)
+    {
+        util::log::record
+        (
+            "Unable to reallocate a mapping from a file address to memory file",
+            util::log::type::ERROR
+        );
+
+        return mmap::EXTERNAL_ERROR_CODE;
+    }
+    this->file_address        = file_address;
+    this->file_capacity_bytes = file_size;
+
+    return mmap::GLOBAL_SUCCESS_CODE;
+}
+
+mmap::status_code
+mmap::memory_file::seal
+(
+    const sys::file::flag_code seal_flag
+) noexcept
+{
+    // Kernel refuses write seal while a writable shared mapping exists
+    const bool remap_flag = (seal_flag & F_SEAL_WRITE) && (this->protocol_flag & PROT_WRITE)
+        && this->file_address;
+    if (remap_flag)
+    {
+        sys::memory::status_code unmap_status = sys::memory::unmap
+        (
+            this->file_address,
+            this->file_capacity_bytes
+        );
+        if (unmap_status == mmap::INTERNAL_ERROR_CODE)
+        {
+            util::log::record
+            (
+                "Unable to unmap memory file before sealing",
+                util::log::type::ERROR
+            );
+
+            return mmap::EXTERNAL_ERROR_CODE;
+        }
+        this->file_address = nullptr;
+    }
+
+    sys::file::status_code seal_status = sys::file::control
+    (
+        this->file_descriptor,
+        F_ADD_SEALS,
+        seal_flag
+    );
+    if (seal_status == mmap::INTERNAL_ERROR_CODE)
+    {
+        util::log::record
+        (
+            "Unable to seal memory file",
+            util::log::type::ERROR
+        );
+
+        // Restore writable mapping
+        if (remap_flag)
+            this->map(this->protocol_flag);
+
+        return mmap::EXTERNAL_ERROR_CODE;
+    }
+
+    if (remap_flag)
+    {
+        this->protocol_flag &= ~PROT_WRITE;
+        if (!this->map(this->protocol_flag))
+            return mmap::EXTERNAL_ERROR_CODE;
+    }
+
+    return mmap::GLOBAL_SUCCESS_CODE;
+}
+
+sys::file::flag_code
+mmap::memory_file::seals() const noexcept
+{
+    return sys::file::control(this->file_descriptor, F_GET_SEALS);
+}
+
+
+mmap::status_code
+mmap::memory_file::send
+(
+    const sys::file::descriptor socket
+) const noexcept
+{
+    char    token  = DESCRIPTOR_TOKEN;
+    iovec   vector = {&token, sizeof(token)};
+    alignas(cmsghdr) char control[CMSG_SPACE(sizeof(sys::file::descriptor))] = {};
+
+    msghdr message         = {};
+    message.msg_iov        = &vector;
+    message.msg_iovlen     = 1;
+    message.msg_control    = control;
+    message.msg_controllen = sizeof(control);
+
+    // Descriptor travels as ancillary rights
+    cmsghdr *header    = CMSG_FIRSTHDR(&message);
+    header->cmsg_level = SOL_SOCKET;
+    header->cmsg_type  = SCM_RIGHTS;
+    header->cmsg_len   = CMSG_LEN(sizeof(sys::file::descriptor));
+    std::memcpy(CMSG_DATA(header), &this->file_descriptor, sizeof(sys::file::descriptor));
+
+    sys::socket::status_code send_status = sys::socket::send(socket, &message, MSG_NOSIGNAL);
+    if (send_status == mmap::INTERNAL_ERROR_CODE)
+    {
+        util::log::record
+        (
+            "Unable to send memory file descriptor",
+            util::log::type::ERROR
+        );
+
+        return mmap::EXTERNAL_ERROR_CODE;
+    }
+
+    return mmap::GLOBAL_SUCCESS_CODE;
+}
+
+sys::file::descriptor
+mmap::memory_file::receive
+(
+    const sys::file::descriptor socket
+) noexcept
+{
+    char    token  = 0;
+    iovec   vector = {&token, sizeof(token)};
+    alignas(cmsghdr) char control[CMSG_SPACE(sizeof(sys::file::descriptor))] = {};
+
+    msghdr message         = {};
+    message.msg_iov        = &vector;
+    message.msg_iovlen     = 1;
+    message.msg_control    = control;
+    message.msg_controllen = sizeof(control);
+
+    sys::socket::status_code receive_status = sys::socket::receive
+    (
+        socket,
+        &message,
+        MSG_CMSG_CLOEXEC
+    );
+    if (receive_status <= 0)
+    {
+        util::log::record
+        (
+            "Unable to receive memory file descriptor",
+            util::log::type::ERROR
+        );
+
+        return mmap::INTERNAL_ERROR_CODE;
+    }
+
+    // Kernel installs whatever descriptors fit, even when it truncates;
+    // keep the first and close the rest
+    sys::file::descriptor file_descriptor = mmap::INTERNAL_ERROR_CODE;
+    for (cmsghdr *header = CMSG_FIRSTHDR(&message); header; header = CMSG_NXTHDR(&message, header))
+    {
+        if (header->cmsg_level != SOL_SOCKET || header->cmsg_type != SCM_RIGHTS)
+            continue;
+
+        const size_type count = (header->cmsg_len - CMSG_LEN(0)) / sizeof(sys::file::descriptor);
+        for (size_type index = 0; index < count; ++index)
+        {
+            sys::file::descriptor received;
+            std::memcpy
+            (
+                &received,
+                CMSG_DATA(header) + index * sizeof(sys::file::descriptor),
+                sizeof(sys::file::descriptor)
+            );
+
+            if (file_descriptor == mmap::INTERNAL_ERROR_CODE)
+                file_descriptor = received;
+            else
+                sys::file::close(received);
+        }
+    }
+
+    if (file_descriptor == mmap::INTERNAL_ERROR_CODE || (message.msg_flags & MSG_CTRUNC))
+    {
+        util::log::record
+        (
+            "Message carried no memory file descriptor",
+            util::log::type::ERROR
+        );
+
+        if (file_descriptor != mmap::INTERNAL_ERROR_CODE)
+            sys::file::close(file_descriptor);
+        return mmap::INTERNAL_ERROR_CODE;
+    }
+
+    return file_descriptor;
+}
+
+
+mmap::address_type
+mmap::memory_file::map
+(
+    const sys::memory::flag_code protocol_flag
+) noexcept
+{
+    address_type file_address = sys::memory::map
+    (
+        nullptr,
+        this->file_capacity_bytes,
+        protocol_flag,
+        MAP_SHARED,
+        this->file_descriptor,
+        0
+    );
+    if (file_address == MAP_FAILED)
+        return nullptr;
+
+    this->file_address = file_address;
+
+    return file_address;
+}
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <string>
+
+#include "file/file.hpp"
+
+
+namespace mmap
+{
+
+// Seals that forbid any further change to size or contents
+constexpr sys::file::flag_code SEAL_IMMUTABLE = F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_WRITE;
+
+// Shared mapping of an anonymous memfd; no path exists, so the descriptor
+// is the only handle and may be sealed and passed to another process
+class memory_file
+{
+private:
+    // Internal file metadata
+    std::string            file_name;
+    size_type              file_capacity_bytes;
+    address_type           file_address;
+    sys::file::descriptor  file_descriptor;
+
+    // Mapping flags
+    sys::memory::flag_code protocol_flag = PROT_READ | PROT_WRITE;
+
+public:
+    // Create a new sealable file; huge page backing falls back to base
+    // pages when none are reserved
+    memory_file
+    (
+        // Required parameters
+        const std::string            &file_name,
+        const size_type               file_size,
+
+        // Advanced parameters
+        const bool                    huge_flag     = false,
+
+        // System call flags
+        const sys::memory::flag_code  protocol_flag = PROT_READ | PROT_WRITE
+    );
+
+    // Adopt a received descriptor; write sealed files map read only. The
+    // descriptor is owned from here on and closed even if adoption throws
+    explicit memory_file
+    (
+        // Required parameters
+        const sys::file::descriptor   file_descriptor,
+
+        // System call flags
+        const sys::memory::flag_code  protocol_flag = PROT_READ | PROT_WRITE
+    );
+
+    virtual ~memory_file() noexcept;
+
+    // No copies permitted
+    memory_file(const memory_file &other)           = delete;
+    memory_file operator=(const memory_file &other) = delete;
+
+    address_type
+    address() const noexcept;
+    size_type
+    capacity() const noexcept;
+    sys::file::descriptor
+    descriptor() const noexcept;
+
+    // Mapping may move
+    status_code
+    resize
+    (
+        const size_type file_size
+    ) noexcept;
+
+    // Sealing writes remaps read only, so the address may change
+    status_code
+    seal
+    (
+        const sys::file::flag_code seal_flag = mmap::SEAL_IMMUTABLE
+    ) noexcept;
+    sys::file::flag_code
+    seals() const noexcept;
+
+    // Pass descriptor over a connected UNIX domain socket
+    status_code
+    send
+    (
+        const sys::file::descriptor socket
+    ) const noexcept;
+
+    static sys::file::descriptor
+    receive
+    (
+        const sys::file::descriptor socket
+    ) noexcept;
+
+protected:
+    address_type
+    map
+    (
+        const sys::memory::flag_code protocol_flag
+    ) noexcept;
+};
+
+} // mmap namespace
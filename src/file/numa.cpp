@@ -0,0 +1,429 @@
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <exception>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <pthread.h>
+#include <sched.h>
+
+#include <lib/numa.hpp>
+#include <util/record.hpp>
+
+#include "numa.hpp"
+
+
+namespace
+{
+
+constexpr char NODE_ONLINE_PATH[] = "/sys/devices/system/node/online";
+constexpr char NODE_PATH_PREFIX[] = "/sys/devices/system/node/node";
+
+constexpr mmap::size_type MASK_WORD_BITS = 8 * sizeof(sys::numa::node_mask);
+
+// Parse kernel list format, e.g. "0-3,8,10-11"
+std::vector<mmap::size_type>
+parse_list
+(
+    const std::string &path
+)
+{
+    std::vector<mmap::size_type> values;
+
+    std::ifstream stream(path);
+    std::string   list;
+    if (!std::getline(stream, list))
+        return values;
+
+    std::stringstream ranges(list);
+    std::string       range;
+    while (std::getline(ranges, range, ','))
+    {
+        if (range.empty())
+            continue;
+
+        const std::size_t dash  = range.find('-');
+        const mmap::size_type first = std::stoul(range.substr(0, dash));
+        const mmap::size_type last  = (dash == std::string::npos)
+            ? first
+            : std::stoul(range.substr(dash + 1));
+
+        for (mmap::size_type value = first; value <= last; ++value)
+            values.push_back(value);
+    }
+
+    return values;
+}
+
+// Pin calling thread to the CPUs local to node
+void
+pin
+(
+    const mmap::node_type node
+)
+{
+    const std::vector<mmap::size_type> cpus = parse_list
+    (
+        NODE_PATH_PREFIX + std::to_string(node) + "/cpulist"
+    );
+
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    for (mmap::size_type cpu: cpus)
+        CPU_SET(cpu, &cpu_set);
+
+    if (!cpus.empty())
+        pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set);
+}
+
+} // anonymous namespace
+
+
+std::vector<mmap::node_type>
+mmap::numa::nodes() noexcept
+{
+    try
+    {
+        std::vector<node_type> nodes = parse_list(NODE_ONLINE_PATH);
+        if (nodes.empty())
+            nodes.push_back(0);
+
+        return nodes;
+    }
+
+    catch (const std::exception &exception)
+    {
+        return {0};
+    }
+}
+
+mmap::size_type
+mmap::numa::slice_size
+(
+    const size_type capacity,
+    const size_type node_count
+) noexcept
+{
+    // Slices stay page aligned so each page belongs to exactly one node
+    const size_type page_size  = sys::memory::page_size;
+    const size_type page_count = (capacity + page_size - 1) / page_size;
+    const size_type count      = std::max<size_type>(1, node_count);
+
+    return ((page_count + count - 1) / count) * page_size;
+}
+
+
+mmap::status_code
+mmap::numa::place
+(
+    address_type    address,
+    const size_type capacity,
+    const placement policy,
+    const node_type node,
+    const bool      populate
+) noexcept
+{
+    // Single node machines have nothing to place
+    const std::vector<node_type> nodes = mmap::numa::nodes();
+    if (nodes.size() < 2)
+        return mmap::GLOBAL_SUCCESS_CODE;
+
+    const node_type max_node   = *std::max_element(nodes.begin(), nodes.end());
+    const size_type mask_words = max_node / MASK_WORD_BITS + 1;
+
+    // Build (address range, node mask, policy) requests
+    struct request
+    {
+        std::uint8_t                        *address;
+        size_type                            capacity;
+        std::vector<sys::numa::node_mask>    mask;
+        sys::numa::flag_code                 policy;
+        node_type                            node;
+    };
+    std::vector<request> requests;
+
+    try
+    {
+        std::vector<sys::numa::node_mask> mask(mask_words, 0);
+        std::uint8_t *base = static_cast<std::uint8_t *>(address);
+
+        switch (policy)
+        {
+        case mmap::placement::LOCAL:
+            requests.push_back({base, capacity, mask, sys::numa::POLICY_DEFAULT, node});
+            break;
+
+        case mmap::placement::BIND:
+            if (std::find(nodes.begin(), nodes.end(), node) == nodes.end())
+            {
+                util::log::record
+                (
+                    "Requested NUMA node is not online",
+                    util::log::type::ERROR
+                );
+
+                return mmap::EXTERNAL_ERROR_CODE;
+            }
+            mask[node / MASK_WORD_BITS] |= sys::numa::node_mask(1) << (node % MASK_WORD_BITS);
+            requests.push_back({base, capacity, mask, sys::numa::POLICY_BIND, node});
+            break;
+
+        case mmap::placement::INTERLEAVE:
+            for (node_type online: nodes)
+                mask[online / MASK_WORD_BITS] |= sys::numa::node_mask(1) << (online % MASK_WORD_BITS);
+            requests.push_back({base, capacity, mask, sys::numa::POLICY_INTERLEAVE, node});
+            break;
+
+        case mmap::placement::PARTITION:
+        {
+            const size_type slice = mmap::numa::slice_size(capacity, nodes.size());
+            for (size_type index = 0; index < nodes.size(); ++index)
+            {
+                const size_type start = index * slice;
+                if (start >= capacity)
+                    break;
+
+                std::vector<sys::numa::node_mask> slice_mask(mask_words, 0);
+                slice_mask[nodes[index] / MASK_WORD_BITS]
+                    |= sys::numa::node_mask(1) << (nodes[index] % MASK_WORD_BITS);
+
+                requests.push_back
+                ({
+                    base + start,
+                    std::min(slice, capacity - start),
+                    slice_mask,
+                    sys::numa::POLICY_BIND,
+                    nodes[index]
+                });
+            }
+            break;
+        }
+
+        default:
+            util::log::record
+            (
+                "Unknown NUMA placement policy",
+                util::log::type::ERROR
+            );
+
+            return mmap::EXTERNAL_ERROR_CODE;
+        }
+    }
+
+    catch (...)
+    {
+        return mmap::EXTERNAL_ERROR_CODE;
+    }
+
+    // Fault each range from a worker under its policy so new page cache
+    // pages land where requested
+    if (populate && policy != mmap::placement::LOCAL)
+    {
+        std::atomic<bool> unsupported = false;
+        std::atomic<bool> failed      = false;
+
+        std::vector<std::thread> workers;
+        try
+        {
+            for (const request &request: requests)
+            {
+                workers.emplace_back
+                (
+                    [&request, &unsupported, &failed, mask_words]()
+                    {
+                        sys::numa::status_code policy_status = sys::numa::policy
+                        (
+                            request.policy,
+                            request.mask.data(),
+                            mask_words * MASK_WORD_BITS + 1
+                        );
+                        if (policy_status == mmap::INTERNAL_ERROR_CODE)
+                        {
+                            if (errno == ENOSYS)
+                                unsupported = true;
+                            else
+                                failed = true;
+
+                            return;
+                        }
+
+                        // Bound ranges fault from their node's CPUs
+                        try
+                        {
+                            if (request.policy == sys::numa::POLICY_BIND)
+                                pin(request.node);
+                        }
+
+                        catch (...)
+                        {
+                        }
+
+                        const size_type page_size = sys::memory::page_size;
+                        for (size_type offset = 0; offset < request.capacity; offset += page_size)
+                            static_cast<void>(*static_cast<volatile std::uint8_t *>(request.address + offset));
+                    }
+                );
+            }
+        }
+
+        catch (...)
+        {
+            failed = true;
+        }
+
+        for (std::thread &worker: workers)
+            worker.join();
+
+        // Kernels built without NUMA support degrade to first touch
+        if (unsupported)
+            return mmap::GLOBAL_SUCCESS_CODE;
+
+        if (failed)
+        {
+            util::log::record
+            (
+                "Unable to populate mapping under NUMA memory policy",
+                util::log::type::ERROR
+            );
+
+            return mmap::EXTERNAL_ERROR_CODE;
+        }
+    }
+
+    // Apply policies, migrating pages already faulted in
+    for (request &request: requests)
+    {
+        const bool default_policy = request.policy == sys::numa::POLICY_DEFAULT;
+        sys::numa::status_code bind_status = sys::numa::bind
+        (
+            request.address,
+            request.capacity,
+            request.policy,
+            default_policy ? nullptr : request.mask.data(),
+            default_policy ? 0 : mask_words * MASK_WORD_BITS + 1,
+            default_policy ? 0 : sys::numa::MOVE_PAGES
+        );
+        if (bind_status == mmap::INTERNAL_ERROR_CODE)
+        {
+            // Kernels built without NUMA support degrade to first touch
+            if (errno == ENOSYS)
+                return mmap::GLOBAL_SUCCESS_CODE;
+
+            util::log::record
+            (
+                "Unable to apply NUMA memory policy to mapping",
+                util::log::type::ERROR
+            );
+
+            return mmap::EXTERNAL_ERROR_CODE;
+        }
+    }
+
+    return mmap::GLOBAL_SUCCESS_CODE;
+}
+
+
+mmap::status_code
+mmap::numa::scan
+(
+    const file          &mapping,
+    const scan_function &function
+) noexcept
+{
+    // Check if mapped
+    if (!mapping.address())
+    {
+        util::log::record
+        (
+            "Memory is not yet mapped",
+            util::log::type::ERROR
+        );
+
+        return mmap::EXTERNAL_ERROR_CODE;
+    }
+
+    std::uint8_t   *base     = static_cast<std::uint8_t *>(mapping.address());
+    const size_type capacity = mapping.capacity();
+
+    // Single node machines scan inline
+    const std::vector<node_type> nodes = mmap::numa::nodes();
+    if (nodes.size() < 2)
+    {
+        try
+        {
+            function(base, capacity, nodes.front());
+        }
+
+        catch (...)
+        {
+            util::log::record
+            (
+                "NUMA scan worker failed",
+                util::log::type::ERROR
+            );
+
+            return mmap::EXTERNAL_ERROR_CODE;
+        }
+
+        return mmap::GLOBAL_SUCCESS_CODE;
+    }
+
+    // One worker per node over the same slices as partitioned placement
+    const size_type   slice  = mmap::numa::slice_size(capacity, nodes.size());
+    std::atomic<bool> failed = false;
+
+    std::vector<std::thread> workers;
+    try
+    {
+        for (size_type index = 0; index < nodes.size(); ++index)
+        {
+            const size_type start = index * slice;
+            if (start >= capacity)
+                break;
+
+            const node_type node   = nodes[index];
+            const size_type length = std::min(slice, capacity - start);
+            workers.emplace_back
+            (
+                [&function, &failed, base, start, length, node]()
+                {
+                    try
+                    {
+                        pin(node);
+                        function(base + start, length, node);
+                    }
+
+                    catch (...)
+                    {
+                        failed = true;
+                    }
+                }
+            );
+        }
+    }
+
+    catch (...)
+    {
+        failed = true;
+    }
+
+    for (std::thread &worker: workers)
+        worker.join();
+
+    if (failed)
+    {
+        util::log::record
+        (
+            "NUMA scan worker failed",
+            util::log::type::ERROR
+        );
+
+        return mmap::EXTERNAL_ERROR_CODE;
+    }
+
+    return mmap::GLOBAL_SUCCESS_CODE;
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <functional>
+#include <vector>
+
+#include "file/file.hpp"
+
+
+namespace mmap
+{
+
+namespace numa
+{
+
+// Worker body run on the node holding its slice of a mapping
+using scan_function = std::function<void(address_type, size_type, node_type)>;
+
+// Online memory nodes; a single node 0 when topology is unavailable
+std::vector<node_type>
+nodes() noexcept;
+
+// Byte length of each node's slice of a partitioned mapping
+size_type
+slice_size
+(
+    const size_type capacity,
+    const size_type node_count
+) noexcept;
+
+// Bind, interleave, or partition a mapped range across nodes. The range
+// policy only steers pages of private and anonymous mappings; page cache
+// pages of a shared file mapping follow the policy of the faulting thread.
+// With populate set, the range is faulted in first by workers running
+// under the requested policy, then pages already cached elsewhere are
+// migrated when no other process maps them.
+// Pages evicted later and faulted back in by other threads may land on
+// any node.
+status_code
+place
+(
+    address_type    address,
+    const size_type capacity,
+    const placement policy,
+    const node_type node     = 0,
+    const bool      populate = false
+) noexcept;
+
+// Run one worker per node over the slice partition of a mapping
+status_code
+scan
+(
+    const file          &mapping,
+    const scan_function &function
+) noexcept;
+
+} // numa namespace
+
+} // mmap namespace
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "file/file.hpp"
+#include "file/header.hpp"
+#include "file/stream.hpp"
 
 
 namespace mmap
@@ -14,8 +16,15 @@ private:
     size_type    file_capacity;
     size_type    file_offset;
 
+    // Self-describing header
+    bool         header_flag    = false;
+    size_type    header_offset  = 0;
+    file_header *header_address = nullptr;
+
 public:
     using file::address;
+    using file::capacity;
+    using file::offset;
 
     ordered_file
     (
@@ -33,7 +42,11 @@ public:
         const sys::memory::flag_code  protocol_flag = PROT_READ | PROT_WRITE,
         const sys::memory::flag_code  mapping_flag  = MAP_SHARED,
         const sys::memory::flag_code  sync_flag     = MS_ASYNC,
-        const sys::memory::flag_code  remap_flag    = MREMAP_MAYMOVE
+        const sys::memory::flag_code  remap_flag    = MREMAP_MAYMOVE,
+        const sys::file::flag_code    allocate_flag = mmap::NO_ALLOCATE,
+
+        // Layout flags
+        const bool                    header_flag   = false
     );
 
     virtual ~ordered_file() noexcept;
@@ -42,6 +55,51 @@ public:
     ordered_file(const ordered_file &other)           = delete;
     ordered_file operator=(const ordered_file &other) = delete; 
 
+    data_type *
+    data() const noexcept;
+    size_type
+    size() const noexcept;
+    data_type &
+    operator[]
+    (
+        const size_type index
+    ) const noexcept;
+
+    size_type
+    count() const noexcept;
+    void
+    count
+    (
+        const size_type element_count
+    ) noexcept;
+
+    // Bulk initialization split across threads; large ranges bypass caches
+    status_code
+    fill
+    (
+        const data_type &value,
+        const size_type  index,
+        const size_type  count,
+        const size_type  thread_count = 1
+    ) noexcept;
+    template <typename generator_type>
+    status_code
+    generate
+    (
+        generator_type  &&generator,
+        const size_type   index,
+        const size_type   count,
+        const size_type   thread_count = 1
+    ) noexcept;
+    status_code
+    assign
+    (
+        const data_type *source,
+        const size_type  index,
+        const size_type  count,
+        const size_type  thread_count = 1
+    ) noexcept;
+
     address_type 
     virtual open() noexcept override;
     address_type 
@@ -53,6 +111,41 @@ public:
         sys::memory::flag_code mapping_flag
     ) noexcept;     
 
+    status_code
+    virtual preallocate
+    (
+        const size_type             index,
+        const size_type             count,
+        const sys::file::flag_code  allocate_flag
+    ) noexcept override;
+    status_code
+    virtual discard
+    (
+        const size_type index,
+        const size_type count
+    ) noexcept override;
+
+    status_code
+    virtual lock
+    (
+        const size_type  index,
+        const size_type  count,
+        const range_lock mode = range_lock::EXCLUSIVE
+    ) noexcept override;
+    status_code
+    virtual try_lock
+    (
+        const size_type  index,
+        const size_type  count,
+        const range_lock mode = range_lock::EXCLUSIVE
+    ) noexcept override;
+    status_code
+    virtual unlock
+    (
+        const size_type  index,
+        const size_type  count
+    ) noexcept override;
+
     status_code
     virtual flush() noexcept override;
     status_code 
@@ -85,7 +178,24 @@ public:
     ) noexcept;
 
 protected:
+    status_code
+    open_header
+    (
+        sys::memory::flag_code protocol_flag
+    ) noexcept;
+    status_code
+    close_header() noexcept;
+
+    bool
+    valid_range
+    (
+        const size_type index,
+        const size_type count
+    ) const noexcept;
+
     using file::valid_path;
 };
 
 } // mmap namespace
+
+#include "file/ordered_file.tpp"
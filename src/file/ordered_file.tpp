@@ -0,0 +1,1050 @@
+#include <ios>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#include <util/record.hpp>
+
+
+template <typename data_type>
+mmap::ordered_file<data_type>::ordered_file
+(
+    // Required parameters
+    const std::string            &file_path,
+    const size_type               file_capacity,
+
+    // Advanced parameters
+    const size_type               file_index,
+    const address_type            base_address,
+
+    // System call flags
+    const sys::file::flag_code    open_flag,
+    const sys::file::flag_code    lock_flag,
+    const sys::memory::flag_code  protocol_flag,
+    const sys::memory::flag_code  mapping_flag,
+    const sys::memory::flag_code  sync_flag,
+    const sys::memory::flag_code  remap_flag,
+    const sys::file::flag_code    allocate_flag,
+
+    // Layout flags
+    const bool                    header_flag
+):  file
+    (
+        file_path, 
+        file_capacity * sizeof(data_type), 
+        file_index * sizeof(data_type),
+        base_address,
+        open_flag,
+        lock_flag,
+        protocol_flag,
+        mapping_flag,
+        sync_flag,
+        remap_flag,
+        allocate_flag
+    )
+{
+    // Validate file path
+    bool valid_path = mmap::ordered_file<data_type>::valid_path(file_path);
+    if (!valid_path)
+    {
+        util::log::record
+        (
+            "File does not have a valid path: "
+            "parent directory and/or file path does not exist",
+            util::log::type::ABORT
+        );
+
+        throw std::runtime_error("Provided file path is invalid");
+    } 
+
+    // metadata
+    this->file_path     = file_path;
+    this->file_capacity = file_capacity * sizeof(data_type);
+    this->file_offset   = file_index * sizeof(data_type);
+    this->base_address  = base_address;
+
+    // flags
+    this->open_flag     = open_flag;
+    this->lock_flag     = lock_flag;
+    this->protocol_flag = protocol_flag;
+    this->mapping_flag  = mapping_flag;
+    this->sync_flag     = sync_flag;
+    this->remap_flag    = remap_flag;
+    this->allocate_flag = allocate_flag;
+    this->header_flag   = header_flag;
+}
+
+template <typename data_type>
+mmap::ordered_file<data_type>::~ordered_file() noexcept
+{
+    this->wait();
+    if (this->file_address)
+        this->close();
+}
+
+
+template <typename data_type>
+mmap::address_type
+inline mmap::ordered_file<data_type>::open() noexcept
+{
+    return this->open_and_map
+    (
+        this->open_flag,
+        this->lock_flag,
+        this->protocol_flag,
+        this->mapping_flag
+    );
+}
+
+template <typename data_type>
+mmap::address_type
+mmap::ordered_file<data_type>::open_and_map
+(
+    sys::file::flag_code open_flag,
+    sys::file::flag_code lock_flag,
+    sys::file::flag_code protocol_flag,
+    sys::file::flag_code mapping_flag
+) noexcept
+{
+    // Check if mapped
+    if (this->file_address)
+    {
+        util::log::record
+        (
+            "Memory is already mapped to file; "
+            "call remap for reallocation",
+            util::log::type::ERROR
+        );
+
+        return nullptr;
+    }
+    
+    // Check file path is still valid
+    bool valid_path = mmap::ordered_file<data_type>::valid_path(file_path);
+    if (!valid_path)
+    {
+        util::log::record
+        (
+            "File does not have a valid path: "
+            "parent directory and/or file path does not exist",
+            util::log::type::ERROR
+        );
+
+        return nullptr;
+    }
+
+    // Open file and get file descriptor
+    sys::file::descriptor file_descriptor = sys::file::open
+    (
+        this->file_path.c_str(), 
+        open_flag,
+        mmap::CREATE_MODE
+    );
+    if (file_descriptor == mmap::INTERNAL_ERROR_CODE)
+    {
+        util::log::record
+        (
+            "Unable to open file and failed to recieve file descriptor",
+            util::log::type::ERROR
+        );
+
+        return nullptr;
+    }
+    this->file_descriptor = file_descriptor;
+
+    // Lock file
+    sys::file::status_code lock_status = sys::file::lock
+    (
+        this->file_descriptor,
+        lock_flag
+    );
+    if (lock_status == mmap::INTERNAL_ERROR_CODE)
+    {
+        util::log::record
+        (
+            "Unable to place lock on file for mapping process",
+            util::log::type::ERROR
+        );
+
+        sys::file::close(this->file_descriptor);
+        this->file_descriptor = mmap::INTERNAL_ERROR_CODE;
+        return nullptr;
+    }
+
+    // Size file from its header, or resize to provided size
+    if (this->header_flag)
+    {
+        mmap::status_code header_status = this->open_header(protocol_flag);
+        if (header_status == mmap::EXTERNAL_ERROR_CODE)
+        {
+            util::log::record
+            (
+                "Unable to open file header",
+                util::log::type::ERROR
+            );
+
+            return nullptr;
+        }
+    }
+
+    else
+    {
+        sys::file::status_code resize_status = sys::file::resize
+        (
+            this->file_descriptor,
+            this->file_offset + this->file_capacity
+        );
+        if (resize_status == mmap::INTERNAL_ERROR_CODE)
+        {
+            util::log::record
+            (
+                "Unable to resize file to provided size",
+                util::log::type::ERROR
+            );
+
+            return nullptr;
+        }
+    }
+
+    // Reserve blocks up front so writes cannot fault on a full device
+    if (this->allocate_flag != mmap::NO_ALLOCATE)
+    {
+        mmap::status_code allocate_status = mmap::file::preallocate
+        (
+            0,
+            this->file_capacity,
+            this->allocate_flag
+        );
+        if (allocate_status == mmap::EXTERNAL_ERROR_CODE)
+            return nullptr;
+    }
+
+    // Map file
+    address_type file_address = sys::memory::map
+    (
+        base_address,
+        this->file_capacity, 
+        protocol_flag,
+        mapping_flag,
+        this->file_descriptor, 
+        this->header_offset + this->file_offset
+    );
+    if (file_address == MAP_FAILED)
+    {
+        util::log::record
+        (
+            "Unable to allocate a mapping from a file address to file",
+            util::log::type::ERROR
+        );
+
+        return nullptr;
+    }
+    this->file_address = file_address;
+
+    return this->file_address;
+}
+
+
+template <typename data_type>
+mmap::status_code
+mmap::ordered_file<data_type>::preallocate
+(
+    const size_type             index,
+    const size_type             count,
+    const sys::file::flag_code  allocate_flag
+) noexcept
+{
+    return mmap::file::preallocate
+    (
+        index * sizeof(data_type),
+        count * sizeof(data_type),
+        allocate_flag
+    );
+}
+
+template <typename data_type>
+mmap::status_code
+mmap::ordered_file<data_type>::discard
+(
+    const size_type index,
+    const size_type count
+) noexcept
+{
+    return mmap::file::discard
+    (
+        index * sizeof(data_type),
+        count * sizeof(data_type)
+    );
+}
+
+template <typename data_type>
+mmap::status_code
+mmap::ordered_file<data_type>::lock
+(
+    const size_type  index,
+    const size_type  count,
+    const range_lock mode
+) noexcept
+{
+    return mmap::file::lock
+    (
+        index * sizeof(data_type),
+        count * sizeof(data_type),
+        mode
+    );
+}
+
+template <typename data_type>
+mmap::status_code
+mmap::ordered_file<data_type>::try_lock
+(
+    const size_type  index,
+    const size_type  count,
+    const range_lock mode
+) noexcept
+{
+    return mmap::file::try_lock
+    (
+        index * sizeof(data_type),
+        count * sizeof(data_type),
+        mode
+    );
+}
+
+template <typename data_type>
+mmap::status_code
+mmap::ordered_file<data_type>::unlock
+(
+    const size_type  index,
+    const size_type  count
+) noexcept
+{
+    return mmap::file::unlock
+    (
+        index * sizeof(data_type),
+        count * sizeof(data_type)
+    );
+}
+
+template <typename data_type>
+mmap::status_code
+inline mmap::ordered_file<data_type>::flush() noexcept
+{
+    return this->flush
+    (
+        this->file_address,
+        this->file_capacity / sizeof(data_type),
+        this->sync_flag
+    );
+}
+
+template <typename data_type>
+mmap::status_code
+mmap::ordered_file<data_type>::flush
+(
+    mmap::address_type     file_address,
+    mmap::size_type        size,
+    sys::memory::flag_code sync_flag
+) noexcept
+{
+    // Check if mapped
+    if (!this->file_address)
+    {
+        util::log::record
+        (
+            "Memory is not yet mapped",
+            util::log::type::ERROR
+        );
+
+        return mmap::EXTERNAL_ERROR_CODE;
+    }
+    
+    // Check file path is still valid
+    bool valid_path = mmap::ordered_file<data_type>::valid_path(file_path);
+    if (!valid_path)
+    {
+        util::log::record
+        (
+            "File does not have a valid path: "
+            "parent directory and/or file path does not exist",
+            util::log::type::ERROR
+        );
+
+        return mmap::EXTERNAL_ERROR_CODE;
+    }
+
+    // Flush kernel buffer to file
+    sys::memory::status_code sync_status = sys::memory::sync
+    (
+        file_address,
+        size * sizeof(data_type),
+        sync_flag
+    );
+    if (sync_status == mmap::INTERNAL_ERROR_CODE)
+    {
+        std::size_t bound 
+            = reinterpret_cast<std::size_t>(file_address) 
+            + size * sizeof(data_type);
+
+        std::stringstream stream;
+        stream << "Unable to synchronize data chunk from address "
+            << "0x" << std::hex << file_address << " to "<< "0x" << bound;
+
+        util::log::record
+        (
+            stream.str(),
+            util::log::type::ERROR
+        );
+
+        return mmap::EXTERNAL_ERROR_CODE;
+    }
+    this->sync_flag = sync_flag;
+
+    return mmap::GLOBAL_SUCCESS_CODE;
+}
+
+
+template <typename data_type>
+mmap::status_code
+inline mmap::ordered_file<data_type>::close() noexcept
+{
+    return this->close_and_unmap(this->sync_flag);
+}
+
+template <typename data_type>
+mmap::status_code
+mmap::ordered_file<data_type>::close_and_unmap
+(
+    sys::memory::flag_code sync_flag
+) noexcept
+{
+    // Finish outstanding prefault before any early return; joinable
+    // workers would terminate the process on destruction
+    this->wait();
+
+    // Check if mapped
+    if (!this->file_address)
+    {
+        util::log::record
+        (
+            "Memory is not yet mapped",
+            util::log::type::ERROR
+        );
+
+        return mmap::EXTERNAL_ERROR_CODE;
+    }
+
+    // Check file path is still valid
+    bool valid_path = mmap::ordered_file<data_type>::valid_path(file_path);
+    if (!valid_path)
+    {
+        util::log::record
+        (
+            "File does not have a valid path: "
+            "parent directory and/or file path does not exist",
+            util::log::type::ERROR
+        );
+
+        return mmap::EXTERNAL_ERROR_CODE;
+    }
+
+    // Flush data
+    mmap::status_code flush_status = this->flush
+    (
+        this->file_address,
+        this->file_capacity / sizeof(data_type),
+        MS_SYNC
+    );
+    if (flush_status == mmap::EXTERNAL_ERROR_CODE)
+    {
+        util::log::record
+        (
+            "Unable to flush changes to kernel buffer",
+            util::log::type::ERROR
+        );
+
+        return mmap::EXTERNAL_ERROR_CODE;
+    }
+
+    // Unmap file
+    sys::memory::status_code unmap_status = sys::memory::unmap
+    (
+        this->file_address,
+        this->file_capacity
+    );
+    if (unmap_status == mmap::INTERNAL_ERROR_CODE)
+    {
+        util::log::record
+        (
+            "Unable to unmap file from file address",
+            util::log::type::ERROR
+        );
+
+        return mmap::EXTERNAL_ERROR_CODE;
+    }
+
+    // Unmap header
+    if (this->header_address)
+    {
+        mmap::status_code header_status = this->close_header();
+        if (header_status == mmap::EXTERNAL_ERROR_CODE)
+        {
+            util::log::record
+            (
+                "Unable to unmap file header",
+                util::log::type::ERROR
+            );
+
+            return mmap::EXTERNAL_ERROR_CODE;
+        }
+    }
+
+    // Unlock file 
+    sys::file::status_code unlock_status = sys::file::unlock
+    (
+        this->file_descriptor,
+        LOCK_UN
+    );
+    if (unlock_status == INTERNAL_ERROR_CODE)
+    {
+        util::log::record
+        (
+            "Unable to unlock file",
+            util::log::type::ERROR
+        );
+
+        return mmap::EXTERNAL_ERROR_CODE;
+    }
+
+    // Close file
+    sys::file::status_code close_status = sys::file::close
+    (
+        this->file_descriptor
+    );
+    if (close_status == INTERNAL_ERROR_CODE)
+    {
+        util::log::record
+        (
+            "Unable to close file",
+            util::log::type::ERROR
+        );
+
+        return mmap::EXTERNAL_ERROR_CODE;
+    }    
+    this->file_address    = nullptr;
+    this->file_descriptor = mmap::INTERNAL_ERROR_CODE;
+
+    return mmap::GLOBAL_SUCCESS_CODE;
+}
+
+
+template <typename data_type>
+mmap::address_type mmap::ordered_file<data_type>::remap
+(
+    const size_type file_capacity
+) noexcept
+{
+    return this->remap
+    (
+        this->base_address,
+        file_capacity,
+        this->remap_flag
+    );
+}
+
+template <typename data_type>
+mmap::address_type mmap::ordered_file<data_type>::remap
+(
+    const address_type  base_address,
+    const size_type     file_capacity,
+    const flag_code     remap_flag
+) noexcept
+{
+    // Finish outstanding prefault before any early return; joinable
+    // workers would terminate the process on destruction
+    this->wait();
+
+    // Check if mapped
+    if (!this->file_address)
+    {
+        util::log::record
+        (
+            "Memory is not yet mapped",
+            util::log::type::ERROR
+        );
+
+        return nullptr;
+    }
+
+    // Resize file
+    sys::file::status_code resize_status = sys::file::resize
+    (
+        this->file_descriptor,
+        this->header_offset + this->file_offset + file_capacity * sizeof(data_type)
+    );
+    if (resize_status == mmap::INTERNAL_ERROR_CODE)
+    {
+        util::log::record
+        (
+            "Unable to resize file to provided size",
+            util::log::type::ERROR
+        );
+
+        return nullptr;
+    }
+
+    // Reserve blocks of grown range
+    const size_type file_capacity_bytes = file_capacity * sizeof(data_type);
+    if (this->allocate_flag != mmap::NO_ALLOCATE && file_capacity_bytes > this->file_capacity)
+    {
+        mmap::status_code allocate_status = mmap::file::preallocate
+        (
+            this->file_capacity,
+            file_capacity_bytes - this->file_capacity,
+            this->allocate_flag
+        );
+        if (allocate_status == mmap::EXTERNAL_ERROR_CODE)
+            return nullptr;
+    }
+
+    // Remap file
+    address_type file_address = sys::memory::remap
+    (
+        this->file_address,
+        this->file_capacity, 
+        file_capacity * sizeof(data_type),
+        remap_flag,
+        base_address
+    );
+    if (file_address == MAP_FAILED)
+    {
+        util::log::record
+        (
+            "Unable to reallocate a mapping from a file address to file",
+            util::log::type::ERROR
+        );
+
+        return nullptr;
+    }
+    this->file_address        = file_address;
+    this->file_capacity       = file_capacity * sizeof(data_type);
+    this->file_capacity_bytes = this->file_capacity;
+
+    // Record new capacity
+    if (this->header_address)
+    {
+        this->header_address->capacity
+            = (this->file_offset + this->file_capacity) / sizeof(data_type);
+    }
+   
+    return this->file_address;
+}
+
+
+template <typename data_type>
+data_type *
+mmap::ordered_file<data_type>::data() const noexcept
+{
+    return static_cast<data_type *>(this->file_address);
+}
+
+template <typename data_type>
+mmap::size_type
+mmap::ordered_file<data_type>::size() const noexcept
+{
+    return this->file_capacity / sizeof(data_type);
+}
+
+template <typename data_type>
+data_type &
+mmap::ordered_file<data_type>::operator[]
+(
+    const size_type index
+) const noexcept
+{
+    return static_cast<data_type *>(this->file_address)[index];
+}
+
+template <typename data_type>
+mmap::size_type
+mmap::ordered_file<data_type>::count() const noexcept
+{
+    if (!this->header_address)
+        return this->file_capacity / sizeof(data_type);
+
+    return this->header_address->element_count;
+}
+
+template <typename data_type>
+void
+mmap::ordered_file<data_type>::count
+(
+    const size_type element_count
+) noexcept
+{
+    if (this->header_address)
+        this->header_address->element_count = element_count;
+}
+
+template <typename data_type>
+mmap::status_code
+mmap::ordered_file<data_type>::fill
+(
+    const data_type &value,
+    const size_type  index,
+    const size_type  count,
+    const size_type  thread_count
+) noexcept
+{
+    static_assert
+    (
+        std::is_trivially_copyable<data_type>::value,
+        "Bulk fill requires trivially copyable elements"
+    );
+
+    if (!this->valid_range(index, count))
+        return mmap::EXTERNAL_ERROR_CODE;
+
+    mmap::status_code fill_status = mmap::stream::fill
+    (
+        this->data() + index,
+        count * sizeof(data_type),
+        &value,
+        sizeof(data_type),
+        thread_count
+    );
+    if (fill_status == mmap::EXTERNAL_ERROR_CODE)
+        return mmap::EXTERNAL_ERROR_CODE;
+
+    // Grow element count over written range
+    if (index + count > this->count())
+        this->count(index + count);
+
+    return mmap::GLOBAL_SUCCESS_CODE;
+}
+
+template <typename data_type>
+template <typename generator_type>
+mmap::status_code
+mmap::ordered_file<data_type>::generate
+(
+    generator_type  &&generator,
+    const size_type   index,
+    const size_type   count,
+    const size_type   thread_count
+) noexcept
+{
+    static_assert
+    (
+        std::is_trivially_copyable<data_type>::value,
+        "Bulk generate requires trivially copyable elements"
+    );
+
+    if (!this->valid_range(index, count))
+        return mmap::EXTERNAL_ERROR_CODE;
+
+    // Generator is called with absolute element index, possibly concurrently
+    mmap::status_code generate_status = mmap::stream::generate
+    (
+        this->data() + index,
+        count,
+        sizeof(data_type),
+        [&generator, index](const size_type first, const size_type elements, void *staging)
+        {
+            data_type *target = static_cast<data_type *>(staging);
+            for (size_type element = 0; element < elements; ++element)
+                target[element] = generator(index + first + element);
+        },
+        thread_count
+    );
+    if (generate_status == mmap::EXTERNAL_ERROR_CODE)
+        return mmap::EXTERNAL_ERROR_CODE;
+
+    if (index + count > this->count())
+        this->count(index + count);
+
+    return mmap::GLOBAL_SUCCESS_CODE;
+}
+
+template <typename data_type>
+mmap::status_code
+mmap::ordered_file<data_type>::assign
+(
+    const data_type *source,
+    const size_type  index,
+    const size_type  count,
+    const size_type  thread_count
+) noexcept
+{
+    static_assert
+    (
+        std::is_trivially_copyable<data_type>::value,
+        "Bulk assign requires trivially copyable elements"
+    );
+
+    if (!this->valid_range(index, count))
+        return mmap::EXTERNAL_ERROR_CODE;
+
+    mmap::status_code copy_status = mmap::stream::copy
+    (
+        this->data() + index,
+        source,
+        count * sizeof(data_type),
+        thread_count
+    );
+    if (copy_status == mmap::EXTERNAL_ERROR_CODE)
+        return mmap::EXTERNAL_ERROR_CODE;
+
+    if (index + count > this->count())
+        this->count(index + count);
+
+    return mmap::GLOBAL_SUCCESS_CODE;
+}
+
+
+template <typename data_type>
+mmap::status_code
+mmap::ordered_file<data_type>::open_header
+(
+    sys::memory::flag_code protocol_flag
+) noexcept
+{
+    const size_type page_size = sys::memory::page_size;
+
+    // Current file length decides between creating and reading a header
+    off_t file_length = sys::file::seek
+    (
+        this->file_descriptor,
+        0,
+        SEEK_END
+    );
+    if (file_length == mmap::INTERNAL_ERROR_CODE)
+    {
+        util::log::record
+        (
+            "Unable to determine length of file",
+            util::log::type::ERROR
+        );
+
+        return mmap::EXTERNAL_ERROR_CODE;
+    }
+
+    const bool fresh_file = file_length == 0;
+    if (!fresh_file && static_cast<size_type>(file_length) < sizeof(file_header))
+    {
+        util::log::record
+        (
+            "File is too short to hold a header",
+            util::log::type::ERROR
+        );
+
+        return mmap::EXTERNAL_ERROR_CODE;
+    }
+
+    // Writing a new header needs a writable mapping
+    if (fresh_file && !(protocol_flag & PROT_WRITE))
+    {
+        util::log::record
+        (
+            "File has no header and cannot be given one without write protection",
+            util::log::type::ERROR
+        );
+
+        return mmap::EXTERNAL_ERROR_CODE;
+    }
+
+    // New files reserve one page so data stays page aligned
+    if (fresh_file)
+    {
+        sys::file::status_code resize_status = sys::file::resize
+        (
+            this->file_descriptor,
+            page_size + this->file_offset + this->file_capacity
+        );
+        if (resize_status == mmap::INTERNAL_ERROR_CODE)
+        {
+            util::log::record
+            (
+                "Unable to resize file to provided size",
+                util::log::type::ERROR
+            );
+
+            return mmap::EXTERNAL_ERROR_CODE;
+        }
+        file_length = page_size + this->file_offset + this->file_capacity;
+    }
+
+    // Map header
+    address_type header_address = sys::memory::map
+    (
+        nullptr,
+        sizeof(file_header),
+        protocol_flag,
+        MAP_SHARED,
+        this->file_descriptor,
+        0
+    );
+    if (header_address == MAP_FAILED)
+    {
+        util::log::record
+        (
+            "Unable to allocate a mapping from a header address to file",
+            util::log::type::ERROR
+        );
+
+        return mmap::EXTERNAL_ERROR_CODE;
+    }
+    this->header_address = static_cast<file_header *>(header_address);
+
+    if (fresh_file)
+    {
+        file_header &header = *this->header_address;
+        header.magic         = mmap::HEADER_MAGIC;
+        header.version       = mmap::HEADER_VERSION;
+        header.element_size  = sizeof(data_type);
+        header.type_hash     = mmap::type_hash<data_type>();
+        header.element_count = 0;
+        header.capacity      = (this->file_offset + this->file_capacity) / sizeof(data_type);
+        header.data_offset   = page_size;
+    }
+
+    // Reject files written for another layout or type
+    const file_header &header = *this->header_address;
+    const char *mismatch = nullptr;
+    if (header.magic != mmap::HEADER_MAGIC)
+        mismatch = "File header magic does not match; file is not self-describing";
+    else if (header.version != mmap::HEADER_VERSION)
+        mismatch = "File header version is not supported";
+    else if (header.element_size != sizeof(data_type))
+        mismatch = "File header element size does not match data type";
+    else if (header.type_hash != mmap::type_hash<data_type>())
+        mismatch = "File header type hash does not match data type";
+    else if (header.data_offset % page_size != 0)
+        mismatch = "File header data offset is not page aligned";
+    else if (!header.data_offset || header.data_offset > static_cast<size_type>(file_length))
+        mismatch = "File header data offset lies outside file";
+    else if (header.capacity > (file_length - header.data_offset) / sizeof(data_type))
+        mismatch = "File header capacity extends past end of file";
+    else if (header.capacity * sizeof(data_type) < this->file_offset)
+        mismatch = "File header capacity ends before provided offset";
+    else if (this->file_capacity > static_cast<size_type>(-1) - this->file_offset)
+        mismatch = "Provided offset and size exceed addressable range";
+
+    if (mismatch)
+    {
+        util::log::record
+        (
+            mismatch,
+            util::log::type::ERROR
+        );
+
+        this->close_header();
+        return mmap::EXTERNAL_ERROR_CODE;
+    }
+    this->header_offset = header.data_offset;
+
+    // Adopt recorded size; grow only when more was requested
+    const size_type recorded_bytes  = header.capacity * sizeof(data_type);
+    const size_type requested_bytes = this->file_offset + this->file_capacity;
+    if (requested_bytes > recorded_bytes)
+    {
+        if (!(protocol_flag & PROT_WRITE))
+        {
+            util::log::record
+            (
+                "File header cannot record a larger size without write protection",
+                util::log::type::ERROR
+            );
+
+            this->close_header();
+            return mmap::EXTERNAL_ERROR_CODE;
+        }
+
+        sys::file::status_code resize_status = sys::file::resize
+        (
+            this->file_descriptor,
+            this->header_offset + requested_bytes
+        );
+        if (resize_status == mmap::INTERNAL_ERROR_CODE)
+        {
+            util::log::record
+            (
+                "Unable to grow file to provided size",
+                util::log::type::ERROR
+            );
+
+            this->close_header();
+            return mmap::EXTERNAL_ERROR_CODE;
+        }
+        this->header_address->capacity = requested_bytes / sizeof(data_type);
+    }
+
+    else
+        this->file_capacity = recorded_bytes - this->file_offset;
+
+    this->file_capacity_bytes = this->file_capacity;
+    this->file_offset_bytes   = this->header_offset + this->file_offset;
+
+    return mmap::GLOBAL_SUCCESS_CODE;
+}
+
+template <typename data_type>
+mmap::status_code
+mmap::ordered_file<data_type>::close_header() noexcept
+{
+    // Persist header before releasing it
+    sys::memory::sync
+    (
+        this->header_address,
+        sizeof(file_header),
+        MS_SYNC
+    );
+
+    sys::memory::status_code unmap_status = sys::memory::unmap
+    (
+        this->header_address,
+        sizeof(file_header)
+    );
+    if (unmap_status == mmap::INTERNAL_ERROR_CODE)
+        return mmap::EXTERNAL_ERROR_CODE;
+
+    this->header_address = nullptr;
+
+    return mmap::GLOBAL_SUCCESS_CODE;
+}
+
+template <typename data_type>
+bool
+mmap::ordered_file<data_type>::valid_range
+(
+    const size_type index,
+    const size_type count
+) const noexcept
+{
+    // Check if mapped
+    if (!this->file_address)
+    {
+        util::log::record
+        (
+            "Unable to write to an unmapped file",
+            util::log::type::ERROR
+        );
+
+        return false;
+    }
+
+    // Check if range lies within mapping
+    if (index > this->size() || count > this->size() - index)
+    {
+        util::log::record
+        (
+            "Element range exceeds file capacity",
+            util::log::type::ERROR
+        );
+
+        return false;
+    }
+
+    return true;
+}
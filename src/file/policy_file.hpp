@@ -0,0 +1,151 @@
+#pragma once
+
+#include <string>
+
+#include "file/file.hpp"
+
+
+namespace mmap
+{
+
+// Stateless policies; every flag is a compile time constant
+namespace policy
+{
+
+// Access policies
+struct read_write
+{
+    static constexpr sys::file::flag_code   open_flag     = O_RDWR | O_CREAT;
+    static constexpr sys::memory::flag_code protocol_flag = PROT_READ | PROT_WRITE;
+    static constexpr sys::memory::flag_code mapping_flag  = MAP_SHARED;
+    static constexpr bool                   writes_back   = true;
+};
+
+struct read_only
+{
+    static constexpr sys::file::flag_code   open_flag     = O_RDONLY;
+    static constexpr sys::memory::flag_code protocol_flag = PROT_READ;
+    static constexpr sys::memory::flag_code mapping_flag  = MAP_SHARED;
+    static constexpr bool                   writes_back   = false;
+};
+
+struct private_copy
+{
+    static constexpr sys::file::flag_code   open_flag     = O_RDONLY;
+    static constexpr sys::memory::flag_code protocol_flag = PROT_READ | PROT_WRITE;
+    static constexpr sys::memory::flag_code mapping_flag  = MAP_PRIVATE;
+    static constexpr bool                   writes_back   = false;
+};
+
+// Locking policies
+struct no_lock
+{
+    static constexpr bool                 enabled   = false;
+    static constexpr sys::file::flag_code lock_flag = 0;
+};
+
+struct shared_lock
+{
+    static constexpr bool                 enabled   = true;
+    static constexpr sys::file::flag_code lock_flag = LOCK_SH;
+};
+
+struct exclusive_lock
+{
+    static constexpr bool                 enabled   = true;
+    static constexpr sys::file::flag_code lock_flag = LOCK_EX;
+};
+
+// Synchronization policies
+struct no_sync
+{
+    static constexpr bool                   enabled   = false;
+    static constexpr sys::memory::flag_code sync_flag = 0;
+};
+
+struct asynchronous
+{
+    static constexpr bool                   enabled   = true;
+    static constexpr sys::memory::flag_code sync_flag = MS_ASYNC;
+};
+
+struct synchronous
+{
+    static constexpr bool                   enabled   = true;
+    static constexpr sys::memory::flag_code sync_flag = MS_SYNC;
+};
+
+// Growth policies
+struct fixed
+{
+    static constexpr bool                   resizable  = false;
+    static constexpr sys::memory::flag_code remap_flag = 0;
+};
+
+struct growable
+{
+    static constexpr bool                   resizable  = true;
+    static constexpr sys::memory::flag_code remap_flag = MREMAP_MAYMOVE;
+};
+
+} // policy namespace
+
+// File mapping specialized at compile time; calls a policy disables are
+// never emitted and the object carries no flag members
+template
+<
+    typename access_policy,
+    typename lock_policy   = policy::shared_lock,
+    typename sync_policy   = policy::asynchronous,
+    typename growth_policy = policy::growable
+>
+class policy_file
+{
+private:
+    // User provided file metadata
+    std::string           file_path;
+    size_type             file_capacity_bytes;
+    size_type             file_offset_bytes;
+
+    // Internal file metadata
+    address_type          file_address    = nullptr;
+    sys::file::descriptor file_descriptor = mmap::INTERNAL_ERROR_CODE;
+
+public:
+    policy_file
+    (
+        // Required parameters
+        const std::string &file_path,
+        const size_type    file_capacity,
+
+        // Advanced parameters
+        const size_type    file_offset = 0
+    );
+
+    ~policy_file() noexcept;
+
+    // No copies permitted
+    policy_file(const policy_file &other)           = delete;
+    policy_file operator=(const policy_file &other) = delete;
+
+    address_type
+    address() const noexcept;
+    size_type
+    capacity() const noexcept;
+
+    address_type
+    open() noexcept;
+    status_code
+    flush() noexcept;
+    status_code
+    close() noexcept;
+    address_type
+    remap
+    (
+        const size_type file_capacity
+    ) noexcept;
+};
+
+} // mmap namespace
+
+#include "file/policy_file.tpp"
@@ -0,0 +1,391 @@
+#include <stdexcept>
+#include <string>
+
+#include <util/record.hpp>
+
+
+template <typename access_policy, typename lock_policy, typename sync_policy, typename growth_policy>
+mmap::policy_file<access_policy, lock_policy, sync_policy, growth_policy>::policy_file
+(
+    // Required parameters
+    const std::string &file_path,
+    const size_type    file_capacity,
+
+    // Advanced parameters
+    const size_type    file_offset
+)
+{
+    // Validate file path
+    bool valid_path = mmap::file::valid_path(file_path);
+    if (!valid_path)
+    {
+        util::log::record
+        (
+            "File does not have a valid path: "
+            "parent directory and/or file path does not exist",
+            util::log::type::ABORT
+        );
+
+        throw std::runtime_error("Provided file path is invalid");
+    }
+
+    // metadata
+    this->file_path           = file_path;
+    this->file_capacity_bytes = file_capacity;
+    this->file_offset_bytes   = file_offset;
+}
+
+template <typename access_policy, typename lock_policy, typename sync_policy, typename growth_policy>
+mmap::policy_file<access_policy, lock_policy, sync_policy, growth_policy>::~policy_file() noexcept
+{
+    if (this->file_address)
+        this->close();
+}
+
+
+template <typename access_policy, typename lock_policy, typename sync_policy, typename growth_policy>
+inline mmap::address_type
+mmap::policy_file<access_policy, lock_policy, sync_policy, growth_policy>::address() const noexcept
+{
+    return this->file_address;
+}
+
+template <typename access_policy, typename lock_policy, typename sync_policy, typename growth_policy>
+inline mmap::size_type
+mmap::policy_file<access_policy, lock_policy, sync_policy, growth_policy>::capacity() const noexcept
+{
+    return this->file_capacity_bytes;
+}
+
+
+template <typename access_policy, typename lock_policy, typename sync_policy, typename growth_policy>
+mmap::address_type
+mmap::policy_file<access_policy, lock_policy, sync_policy, growth_policy>::open() noexcept
+{
+    // Check if mapped
+    if (this->file_address)
+    {
+        util::log::record
+        (
+            "Memory is already mapped to file; "
+            "call remap for reallocation",
+            util::log::type::ERROR
+        );
+
+        return nullptr;
+    }
+
+    // Open file and get file descriptor
+    sys::file::descriptor file_descriptor = sys::file::open
+    (
+        this->file_path.c_str(),
+        access_policy::open_flag,
+        mmap::CREATE_MODE
+    );
+    if (file_descriptor == mmap::INTERNAL_ERROR_CODE)
+    {
+        util::log::record
+        (
+            "Unable to open file and failed to recieve file descriptor",
+            util::log::type::ERROR
+        );
+
+        return nullptr;
+    }
+    this->file_descriptor = file_descriptor;
+
+    // Lock file
+    if constexpr (lock_policy::enabled)
+    {
+        sys::file::status_code lock_status = sys::file::lock
+        (
+            this->file_descriptor,
+            lock_policy::lock_flag
+        );
+        if (lock_status == mmap::INTERNAL_ERROR_CODE)
+        {
+            util::log::record
+            (
+                "Unable to place lock on file for mapping process",
+                util::log::type::ERROR
+            );
+
+            sys::file::close(this->file_descriptor);
+            this->file_descriptor = mmap::INTERNAL_ERROR_CODE;
+            return nullptr;
+        }
+    }
+
+    // Size writable files to capacity; growth policy only gates remap,
+    // so fixed files are extended but never cut short
+    bool resize_file = access_policy::writes_back && this->file_capacity_bytes != 0;
+    if constexpr (!growth_policy::resizable && access_policy::writes_back)
+    {
+        struct stat file_status;
+        if (resize_file && sys::file::status(this->file_descriptor, &file_status) != mmap::INTERNAL_ERROR_CODE)
+        {
+            resize_file = static_cast<size_type>(file_status.st_size)
+                < this->file_offset_bytes + this->file_capacity_bytes;
+        }
+    }
+
+    // Resize file, or take its size as found
+    if (resize_file)
+    {
+        sys::file::status_code resize_status = sys::file::resize
+        (
+            this->file_descriptor,
+            this->file_offset_bytes + this->file_capacity_bytes
+        );
+        if (resize_status == mmap::INTERNAL_ERROR_CODE)
+        {
+            util::log::record
+            (
+                "Unable to resize file to provided size",
+                util::log::type::ERROR
+            );
+
+            sys::file::close(this->file_descriptor);
+            this->file_descriptor = mmap::INTERNAL_ERROR_CODE;
+            return nullptr;
+        }
+    }
+
+    else if (this->file_capacity_bytes == 0)
+    {
+        off_t file_length = sys::file::seek
+        (
+            this->file_descriptor,
+            0,
+            SEEK_END
+        );
+        if (file_length == mmap::INTERNAL_ERROR_CODE
+            || static_cast<size_type>(file_length) <= this->file_offset_bytes)
+        {
+            util::log::record
+            (
+                "Unable to size mapping from file length",
+                util::log::type::ERROR
+            );
+
+            sys::file::close(this->file_descriptor);
+            this->file_descriptor = mmap::INTERNAL_ERROR_CODE;
+            return nullptr;
+        }
+        this->file_capacity_bytes = file_length - this->file_offset_bytes;
+    }
+
+    // Map file
+    address_type file_address = sys::memory::map
+    (
+        nullptr,
+        this->file_capacity_bytes,
+        access_policy::protocol_flag,
+        access_policy::mapping_flag,
+        this->file_descriptor,
+        this->file_offset_bytes
+    );
+    if (file_address == MAP_FAILED)
+    {
+        util::log::record
+        (
+            "Unable to allocate a mapping from a file address to file",
+            util::log::type::ERROR
+        );
+
+        sys::file::close(this->file_descriptor);
+        this->file_descriptor = mmap::INTERNAL_ERROR_CODE;
+        return nullptr;
+    }
+    this->file_address = file_address;
+
+    return this->file_address;
+}
+
+
+template <typename access_policy, typename lock_policy, typename sync_policy, typename growth_policy>
+mmap::status_code
+mmap::policy_file<access_policy, lock_policy, sync_policy, growth_policy>::flush() noexcept
+{
+    // Nothing reaches file without write back and synchronization
+    if constexpr (!access_policy::writes_back || !sync_policy::enabled)
+        return mmap::GLOBAL_SUCCESS_CODE;
+
+    else
+    {
+        // Check if mapped
+        if (!this->file_address)
+        {
+            util::log::record
+            (
+                "Memory is not yet mapped",
+                util::log::type::ERROR
+            );
+
+            return mmap::EXTERNAL_ERROR_CODE;
+        }
+
+        // Flush kernel buffer to file
+        sys::memory::status_code sync_status = sys::memory::sync
+        (
+            this->file_address,
+            this->file_capacity_bytes,
+            sync_policy::sync_flag
+        );
+        if (sync_status == mmap::INTERNAL_ERROR_CODE)
+        {
+            util::log::record
+            (
+                "Unable to synchronize mapping to file",
+                util::log::type::ERROR
+            );
+
+            return mmap::EXTERNAL_ERROR_CODE;
+        }
+
+        return mmap::GLOBAL_SUCCESS_CODE;
+    }
+}
+
+
+template <typename access_policy, typename lock_policy, typename sync_policy, typename growth_policy>
+mmap::status_code
+mmap::policy_file<access_policy, lock_policy, sync_policy, growth_policy>::close() noexcept
+{
+    // Check if mapped
+    if (!this->file_address)
+    {
+        util::log::record
+        (
+            "Memory is not yet mapped",
+            util::log::type::ERROR
+        );
+
+        return mmap::EXTERNAL_ERROR_CODE;
+    }
+
+    // Flush data
+    if constexpr (access_policy::writes_back && sync_policy::enabled)
+    {
+        sys::memory::status_code sync_status = sys::memory::sync
+        (
+            this->file_address,
+            this->file_capacity_bytes,
+            MS_SYNC
+        );
+        if (sync_status == mmap::INTERNAL_ERROR_CODE)
+        {
+            util::log::record
+            (
+                "Unable to flush changes to kernel buffer",
+                util::log::type::ERROR
+            );
+
+            return mmap::EXTERNAL_ERROR_CODE;
+        }
+    }
+
+    // Unmap file
+    sys::memory::status_code unmap_status = sys::memory::unmap
+    (
+        this->file_address,
+        this->file_capacity_bytes
+    );
+    if (unmap_status == mmap::INTERNAL_ERROR_CODE)
+    {
+        util::log::record
+        (
+            "Unable to unmap file from file address",
+            util::log::type::ERROR
+        );
+
+        return mmap::EXTERNAL_ERROR_CODE;
+    }
+    this->file_address = nullptr;
+
+    // Closing descriptor releases its lock
+    sys::file::status_code close_status = sys::file::close
+    (
+        this->file_descriptor
+    );
+    if (close_status == mmap::INTERNAL_ERROR_CODE)
+    {
+        util::log::record
+        (
+            "Unable to close file",
+            util::log::type::ERROR
+        );
+
+        return mmap::EXTERNAL_ERROR_CODE;
+    }
+    this->file_descriptor = mmap::INTERNAL_ERROR_CODE;
+
+    return mmap::GLOBAL_SUCCESS_CODE;
+}
+
+
+template <typename access_policy, typename lock_policy, typename sync_policy, typename growth_policy>
+mmap::address_type
+mmap::policy_file<access_policy, lock_policy, sync_policy, growth_policy>::remap
+(
+    const size_type file_capacity
+) noexcept
+{
+    static_assert
+    (
+        growth_policy::resizable && access_policy::writes_back,
+        "Only growable, written back mappings can be reallocated"
+    );
+
+    // Check if mapped
+    if (!this->file_address)
+    {
+        util::log::record
+        (
+            "Memory is not yet mapped",
+            util::log::type::ERROR
+        );
+
+        return nullptr;
+    }
+
+    // Resize file
+    sys::file::status_code resize_status = sys::file::resize
+    (
+        this->file_descriptor,
+        this->file_offset_bytes + file_capacity
+    );
+    if (resize_status == mmap::INTERNAL_ERROR_CODE)
+    {
+        util::log::record
+        (
+            "Unable to resize file to provided size",
+            util::log::type::ERROR
+        );
+
+        return nullptr;
+    }
+
+    // Remap file
+    address_type file_address = sys::memory::remap
+    (
+        this->file_address,
+        this->file_capacity_bytes,
+        file_capacity,
+        growth_policy::remap_flag
+    );
+    if (file_address == MAP_FAILED)
+    {
+        util::log::record
+        (
+            "Unable to reallocate a mapping from a file address to file",
+            util::log::type::ERROR
+        );
+
+        return nullptr;
+    }
+    this->file_address        = file_address;
+    this->file_capacity_bytes = file_capacity;
+
+    return this->file_address;
+}
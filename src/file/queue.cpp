@@ -0,0 +1,632 @@
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <exception>
+#include <filesystem>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <util/record.hpp>
+
+#include "queue.hpp"
+
+
+namespace
+{
+
+constexpr char SEGMENT_EXTENSION[] = ".segment";
+constexpr char CONSUMERS_FILE[]    = "consumers";
+
+constexpr mmap::size_type RECORD_HEADER = sizeof(std::uint32_t);
+
+// Length word doubles as the commit flag of its record
+std::atomic<std::uint32_t> &
+record_length
+(
+    mmap::address_type segment_address,
+    mmap::size_type    position
+) noexcept
+{
+    return *reinterpret_cast<std::atomic<std::uint32_t> *>
+    (
+        static_cast<std::uint8_t *>(segment_address) + position
+    );
+}
+
+mmap::size_type
+align_record
+(
+    const mmap::size_type position
+) noexcept
+{
+    return (position + mmap::QUEUE_RECORD_ALIGN - 1)
+        / mmap::QUEUE_RECORD_ALIGN * mmap::QUEUE_RECORD_ALIGN;
+}
+
+// Segment bases present on disk, oldest first
+std::vector<mmap::queue_offset>
+segment_bases
+(
+    const std::string &queue_path
+)
+{
+    std::vector<mmap::queue_offset> bases;
+    for (const auto &entry: std::filesystem::directory_iterator(queue_path))
+    {
+        const std::filesystem::path &path = entry.path();
+        if (path.extension() != SEGMENT_EXTENSION)
+            continue;
+
+        bases.push_back(std::stoull(path.stem().string()));
+    }
+    std::sort(bases.begin(), bases.end());
+
+    return bases;
+}
+
+} // anonymous namespace
+
+
+mmap::queue::queue
+(
+    // Required parameters
+    const std::string &queue_path,
+
+    // Advanced parameters
+    const size_type    segment_size,
+    const size_type    consumer_capacity
+)
+{
+    // Validate queue directory
+    std::error_code error;
+    if (!std::filesystem::is_directory(queue_path, error))
+    {
+        util::log::record
+        (
+            "Queue does not have a valid path: directory does not exist",
+            util::log::type::ABORT
+        );
+
+        throw std::runtime_error("Provided queue path is invalid");
+    }
+
+    // Segment must hold at least one aligned record header
+    if (segment_size % sys::memory::page_size != 0 || segment_size < 2 * QUEUE_RECORD_ALIGN)
+    {
+        util::log::record
+        (
+            "Queue segment size must be a multiple of the page size",
+            util::log::type::ABORT
+        );
+
+        throw std::runtime_error("Provided segment size is invalid");
+    }
+
+    // metadata
+    this->queue_path        = queue_path;
+    this->segment_size      = segment_size;
+    this->consumer_capacity = consumer_capacity;
+}
+
+mmap::queue::~queue() noexcept
+{
+    if (this->consumers)
+        this->close();
+}
+
+
+mmap::status_code
+mmap::queue::open() noexcept
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+
+    // Check if opened
+    if (this->consumers)
+    {
+        util::log::record
+        (
+            "Queue is already open",
+            util::log::type::ERROR
+        );
+
+        return mmap::EXTERNAL_ERROR_CODE;
+    }
+
+    // Map consumer offsets
+    try
+    {
+        this->consumers = std::make_unique<ordered_file<queue_consumer>>
+        (
+            this->queue_path + "/" + CONSUMERS_FILE,
+            this->consumer_capacity,
+            0,
+            nullptr,
+            O_RDWR | O_CREAT,
+            LOCK_EX | LOCK_NB,
+            PROT_READ | PROT_WRITE,
+            MAP_SHARED,
+            MS_ASYNC,
+            MREMAP_MAYMOVE,
+            mmap::NO_ALLOCATE,
+            true
+        );
+    }
+
+    catch (const std::exception &exception)
+    {
+        return mmap::EXTERNAL_ERROR_CODE;
+    }
+
+    if (!this->consumers->open())
+    {
+        util::log::record
+        (
+            "Unable to open queue consumer offsets; queue may be open elsewhere",
+            util::log::type::ERROR
+        );
+
+        this->consumers.reset();
+        return mmap::EXTERNAL_ERROR_CODE;
+    }
+
+    // Resume after last committed record of newest segment
+    std::vector<queue_offset> bases;
+    try
+    {
+        bases = segment_bases(this->queue_path);
+    }
+
+    catch (const std::exception &exception)
+    {
+        util::log::record
+        (
+            "Unable to list queue segments",
+            util::log::type::ERROR
+        );
+
+        return mmap::EXTERNAL_ERROR_CODE;
+    }
+
+    const queue_offset base    = bases.empty() ? 0 : bases.back();
+    file              *current = this->segment(base);
+    if (!current)
+        return mmap::EXTERNAL_ERROR_CODE;
+
+    size_type position = 0;
+    while (position + RECORD_HEADER <= this->segment_size)
+    {
+        const std::uint32_t length = record_length(current->address(), position)
+            .load(std::memory_order_acquire);
+        if (length == 0)
+            break;
+
+        if (length == mmap::QUEUE_ROLL_MARKER)
+        {
+            position = this->segment_size;
+            break;
+        }
+
+        position = align_record(position + RECORD_HEADER + length);
+    }
+    this->tail = base + position;
+
+    return mmap::GLOBAL_SUCCESS_CODE;
+}
+
+mmap::status_code
+mmap::queue::flush() noexcept
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+
+    bool failed = false;
+    for (auto &[base, mapping]: this->segments)
+        failed |= mapping->flush() == mmap::EXTERNAL_ERROR_CODE;
+
+    if (this->consumers)
+        failed |= this->consumers->flush() == mmap::EXTERNAL_ERROR_CODE;
+
+    return failed ? mmap::EXTERNAL_ERROR_CODE : mmap::GLOBAL_SUCCESS_CODE;
+}
+
+mmap::status_code
+mmap::queue::close() noexcept
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+
+    bool failed = false;
+    for (auto &[base, mapping]: this->segments)
+        failed |= mapping->close() == mmap::EXTERNAL_ERROR_CODE;
+    this->segments.clear();
+
+    if (this->consumers)
+    {
+        failed |= this->consumers->close() == mmap::EXTERNAL_ERROR_CODE;
+        this->consumers.reset();
+    }
+
+    return failed ? mmap::EXTERNAL_ERROR_CODE : mmap::GLOBAL_SUCCESS_CODE;
+}
+
+
+mmap::queue_offset
+mmap::queue::append
+(
+    const std::string_view payload
+) noexcept
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+
+    // Check if opened
+    if (!this->consumers)
+    {
+        util::log::record
+        (
+            "Queue is not yet open",
+            util::log::type::ERROR
+        );
+
+        return mmap::INVALID_QUEUE_OFFSET;
+    }
+
+    // Record must fit an empty segment
+    const size_type record_size = RECORD_HEADER + payload.size();
+    if (record_size > this->segment_size || payload.size() >= mmap::QUEUE_ROLL_MARKER)
+    {
+        util::log::record
+        (
+            "Queue record exceeds segment size",
+            util::log::type::ERROR
+        );
+
+        return mmap::INVALID_QUEUE_OFFSET;
+    }
+
+    queue_offset base     = this->tail / this->segment_size * this->segment_size;
+    size_type    position = this->tail - base;
+
+    // Roll to next segment, marking the rest of this one as skipped
+    if (position + record_size > this->segment_size)
+    {
+        file *current = this->segment(base);
+        if (!current)
+            return mmap::INVALID_QUEUE_OFFSET;
+
+        if (position + RECORD_HEADER <= this->segment_size)
+        {
+            record_length(current->address(), position)
+                .store(mmap::QUEUE_ROLL_MARKER, std::memory_order_release);
+        }
+
+        base    += this->segment_size;
+        position = 0;
+    }
+
+    file *current = this->segment(base);
+    if (!current)
+        return mmap::INVALID_QUEUE_OFFSET;
+
+    // Payload first, then length publishes the record to readers
+    std::memcpy
+    (
+        static_cast<std::uint8_t *>(current->address()) + position + RECORD_HEADER,
+        payload.data(),
+        payload.size()
+    );
+    record_length(current->address(), position)
+        .store(static_cast<std::uint32_t>(payload.size()), std::memory_order_release);
+
+    const queue_offset offset = base + position;
+    this->tail = base + align_record(position + record_size);
+
+    return offset;
+}
+
+
+bool
+mmap::queue::read
+(
+    const std::string &consumer,
+    std::string_view  &payload
+) noexcept
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+
+    queue_consumer *slot = this->consumer(consumer);
+    if (!slot)
+        return false;
+
+    for (;;)
+    {
+        const queue_offset base     = slot->offset / this->segment_size * this->segment_size;
+        const size_type    position = slot->offset - base;
+
+        // End of segment without marker
+        if (position + RECORD_HEADER > this->segment_size)
+        {
+            slot->offset = base + this->segment_size;
+            continue;
+        }
+
+        // Never create segments ahead of the producer
+        std::error_code error;
+        if (!this->segments.count(base)
+            && !std::filesystem::exists(this->segment_path(base), error))
+            return false;
+
+        file *current = this->segment(base);
+        if (!current)
+            return false;
+
+        const std::uint32_t length = record_length(current->address(), position)
+            .load(std::memory_order_acquire);
+        if (length == 0)
+            return false;
+
+        if (length == mmap::QUEUE_ROLL_MARKER)
+        {
+            slot->offset = base + this->segment_size;
+            continue;
+        }
+
+        payload = std::string_view
+        (
+            static_cast<const char *>(current->address()) + position + RECORD_HEADER,
+            length
+        );
+        slot->offset = base + align_record(position + RECORD_HEADER + length);
+
+        return true;
+    }
+}
+
+mmap::queue_offset
+mmap::queue::position
+(
+    const std::string &consumer
+) noexcept
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+
+    queue_consumer *slot = this->consumer(consumer);
+    if (!slot)
+        return mmap::INVALID_QUEUE_OFFSET;
+
+    return slot->offset;
+}
+
+mmap::status_code
+mmap::queue::seek
+(
+    const std::string  &consumer,
+    const queue_offset  offset
+) noexcept
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+
+    queue_consumer *slot = this->consumer(consumer);
+    if (!slot)
+        return mmap::EXTERNAL_ERROR_CODE;
+
+    if (offset % mmap::QUEUE_RECORD_ALIGN != 0)
+    {
+        util::log::record
+        (
+            "Queue offset is not aligned to a record boundary",
+            util::log::type::ERROR
+        );
+
+        return mmap::EXTERNAL_ERROR_CODE;
+    }
+    slot->offset = offset;
+
+    return mmap::GLOBAL_SUCCESS_CODE;
+}
+
+
+mmap::status_code
+mmap::queue::retain
+(
+    const size_type segment_count
+) noexcept
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+
+    // Check if opened
+    if (!this->consumers)
+    {
+        util::log::record
+        (
+            "Queue is not yet open",
+            util::log::type::ERROR
+        );
+
+        return mmap::EXTERNAL_ERROR_CODE;
+    }
+
+    std::vector<queue_offset> bases;
+    try
+    {
+        bases = segment_bases(this->queue_path);
+    }
+
+    catch (const std::exception &exception)
+    {
+        util::log::record
+        (
+            "Unable to list queue segments",
+            util::log::type::ERROR
+        );
+
+        return mmap::EXTERNAL_ERROR_CODE;
+    }
+
+    // Producer segment is always kept
+    const queue_offset active = this->tail / this->segment_size * this->segment_size;
+    const size_type    keep   = std::max<size_type>(1, segment_count);
+
+    size_type removed = 0;
+    while (bases.size() - removed > keep && bases[removed] < active)
+    {
+        const queue_offset base = bases[removed];
+
+        auto mapping = this->segments.find(base);
+        if (mapping != this->segments.end())
+        {
+            mapping->second->close();
+            this->segments.erase(mapping);
+        }
+
+        std::error_code error;
+        std::filesystem::remove(this->segment_path(base), error);
+        if (error)
+        {
+            util::log::record
+            (
+                "Unable to remove queue segment " + this->segment_path(base),
+                util::log::type::ERROR
+            );
+
+            return mmap::EXTERNAL_ERROR_CODE;
+        }
+        ++removed;
+    }
+
+    // Nothing listed, e.g. segments deleted externally: no bound to clamp to
+    if (removed == bases.size())
+        return mmap::GLOBAL_SUCCESS_CODE;
+
+    // Lagging consumers continue at oldest retained record
+    const queue_offset oldest = bases[removed];
+    for (size_type index = 0; index < this->consumers->count(); ++index)
+    {
+        queue_consumer &slot = (*this->consumers)[index];
+        if (slot.offset < oldest)
+            slot.offset = oldest;
+    }
+
+    return mmap::GLOBAL_SUCCESS_CODE;
+}
+
+
+mmap::file *
+mmap::queue::segment
+(
+    const queue_offset base
+) noexcept
+{
+    auto found = this->segments.find(base);
+    if (found != this->segments.end())
+        return found->second.get();
+
+    try
+    {
+        auto mapping = std::make_unique<file>
+        (
+            this->segment_path(base),
+            this->segment_size
+        );
+        if (!mapping->open())
+        {
+            util::log::record
+            (
+                "Unable to open queue segment",
+                util::log::type::ERROR
+            );
+
+            return nullptr;
+        }
+
+        file *current = mapping.get();
+        this->segments.emplace(base, std::move(mapping));
+
+        return current;
+    }
+
+    catch (const std::exception &exception)
+    {
+        return nullptr;
+    }
+}
+
+mmap::queue_consumer *
+mmap::queue::consumer
+(
+    const std::string &name
+) noexcept
+{
+    // Check if opened
+    if (!this->consumers)
+    {
+        util::log::record
+        (
+            "Queue is not yet open",
+            util::log::type::ERROR
+        );
+
+        return nullptr;
+    }
+
+    if (name.empty() || name.size() >= mmap::QUEUE_CONSUMER_NAME)
+    {
+        util::log::record
+        (
+            "Queue consumer name is empty or too long",
+            util::log::type::ERROR
+        );
+
+        return nullptr;
+    }
+
+    const size_type count = this->consumers->count();
+    for (size_type index = 0; index < count; ++index)
+    {
+        queue_consumer &slot = (*this->consumers)[index];
+        if (name == slot.name)
+            return &slot;
+    }
+
+    // Register new consumer at oldest available offset
+    if (count >= this->consumers->size())
+    {
+        util::log::record
+        (
+            "Queue consumer capacity exhausted",
+            util::log::type::ERROR
+        );
+
+        return nullptr;
+    }
+
+    queue_consumer &slot = (*this->consumers)[count];
+    std::memset(&slot, 0, sizeof(queue_consumer));
+    std::memcpy(slot.name, name.data(), name.size());
+    try
+    {
+        std::vector<queue_offset> bases = segment_bases(this->queue_path);
+        slot.offset = bases.empty() ? 0 : bases.front();
+    }
+
+    catch (const std::exception &exception)
+    {
+        slot.offset = 0;
+    }
+    this->consumers->count(count + 1);
+
+    return &slot;
+}
+
+std::string
+mmap::queue::segment_path
+(
+    const queue_offset base
+) const
+{
+    std::stringstream stream;
+    stream << this->queue_path << "/" << std::setw(20) << std::setfill('0') << base
+        << SEGMENT_EXTENSION;
+
+    return stream.str();
+}
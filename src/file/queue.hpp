@@ -0,0 +1,125 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+#include "file/file.hpp"
+#include "file/ordered_file.hpp"
+
+
+namespace mmap
+{
+
+using queue_offset = std::uint64_t;
+
+constexpr queue_offset  INVALID_QUEUE_OFFSET = static_cast<queue_offset>(-1);
+constexpr size_type     QUEUE_RECORD_ALIGN   = 8;
+constexpr std::uint32_t QUEUE_ROLL_MARKER    = static_cast<std::uint32_t>(-1);
+constexpr size_type     QUEUE_CONSUMER_NAME  = 56;
+
+// Named read position persisted in the consumer offsets file
+struct queue_consumer
+{
+    char          name[QUEUE_CONSUMER_NAME];
+    std::uint64_t offset;
+};
+
+// Durable log of length-prefixed records in fixed-size segment files
+// under a directory; segment n covers offsets [n, n + segment size). One
+// open queue owns the directory; its threads may produce and consume
+// concurrently, while a second open, here or in another process, fails
+class queue
+{
+private:
+    // User provided queue metadata
+    std::string  queue_path;
+    size_type    segment_size;
+    size_type    consumer_capacity;
+
+    // Internal queue metadata
+    std::map<queue_offset, std::unique_ptr<file>>  segments;
+    std::unique_ptr<ordered_file<queue_consumer>>  consumers;
+    queue_offset                                   tail = 0;
+    std::mutex                                     mutex;
+
+public:
+    queue
+    (
+        // Required parameters
+        const std::string &queue_path,
+
+        // Advanced parameters
+        const size_type    segment_size      = 64 << 20,
+        const size_type    consumer_capacity = 64
+    );
+
+    virtual ~queue() noexcept;
+
+    // No copies permitted
+    queue(const queue &other)           = delete;
+    queue operator=(const queue &other) = delete;
+
+    status_code
+    virtual open() noexcept;
+    status_code
+    virtual flush() noexcept;
+    status_code
+    virtual close() noexcept;
+
+    // Producer side
+    queue_offset
+    append
+    (
+        const std::string_view payload
+    ) noexcept;
+
+    // Consumer side; views stay valid until retention removes the segment
+    bool
+    read
+    (
+        const std::string &consumer,
+        std::string_view  &payload
+    ) noexcept;
+    queue_offset
+    position
+    (
+        const std::string &consumer
+    ) noexcept;
+    status_code
+    seek
+    (
+        const std::string  &consumer,
+        const queue_offset  offset
+    ) noexcept;
+
+    // Delete oldest segments beyond count, moving lagging consumers forward
+    status_code
+    retain
+    (
+        const size_type segment_count
+    ) noexcept;
+
+protected:
+    file *
+    segment
+    (
+        const queue_offset base
+    ) noexcept;
+    queue_consumer *
+    consumer
+    (
+        const std::string &name
+    ) noexcept;
+
+    std::string
+    segment_path
+    (
+        const queue_offset base
+    ) const;
+};
+
+} // mmap namespace
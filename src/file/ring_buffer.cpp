@@ -0,0 +1,415 @@
+#include <stdexcept>
+#include <string>
+
+#include <util/record.hpp>
+
+#include "ring_buffer.hpp"
+
+
+mmap::ring_buffer::ring_buffer
+(
+    // Required parameters
+    const size_type    ring_capacity,
+
+    // Advanced parameters
+    const std::string &file_path
+)
+{
+    // Both views must start on a page boundary
+    const size_type page_size = sys::memory::page_size;
+    if (!ring_capacity)
+    {
+        util::log::record
+        (
+            "Ring buffer capacity must be non-zero",
+            util::log::type::ABORT
+        );
+
+        throw std::runtime_error("Provided ring capacity is invalid");
+    }
+
+    if (!file_path.empty() && !mmap::file::valid_path(file_path))
+    {
+        util::log::record
+        (
+            "Ring buffer does not have a valid path: "
+            "parent directory does not exist",
+            util::log::type::ABORT
+        );
+
+        throw std::runtime_error("Provided ring path is invalid");
+    }
+
+    // metadata
+    this->file_path           = file_path;
+    this->ring_capacity_bytes = (ring_capacity + page_size - 1) / page_size * page_size;
+}
+
+mmap::ring_buffer::~ring_buffer() noexcept
+{
+    if (this->ring_address)
+        this->close();
+}
+
+
+mmap::address_type
+mmap::ring_buffer::open() noexcept
+{
+    // Check if mapped
+    if (this->ring_address)
+    {
+        util::log::record
+        (
+            "Ring buffer is already mapped",
+            util::log::type::ERROR
+        );
+
+        return nullptr;
+    }
+
+    const size_type page_size    = sys::memory::page_size;
+    const size_type backing_size = page_size + this->ring_capacity_bytes;
+
+    // Backing: cursor page followed by data region
+    if (this->file_path.empty())
+    {
+        this->file_descriptor = sys::memory::create("ring_buffer", MFD_CLOEXEC);
+    }
+
+    else
+    {
+        this->file_descriptor = sys::file::open
+        (
+            this->file_path.c_str(),
+            O_RDWR | O_CREAT | O_CLOEXEC,
+            mmap::CREATE_MODE
+        );
+    }
+    if (this->file_descriptor == mmap::INTERNAL_ERROR_CODE)
+    {
+        util::log::record
+        (
+            "Unable to open ring buffer backing and failed to recieve file descriptor",
+            util::log::type::ERROR
+        );
+
+        return nullptr;
+    }
+
+    // Existing file keeps its cursors when the capacity matches
+    struct stat file_status;
+    sys::file::status_code status_status = sys::file::status
+    (
+        this->file_descriptor,
+        &file_status
+    );
+    if (status_status == mmap::INTERNAL_ERROR_CODE
+        || (static_cast<size_type>(file_status.st_size) != backing_size
+            && sys::file::resize(this->file_descriptor, 0) == mmap::INTERNAL_ERROR_CODE)
+        || sys::file::resize(this->file_descriptor, backing_size) == mmap::INTERNAL_ERROR_CODE)
+    {
+        util::log::record
+        (
+            "Unable to size ring buffer backing",
+            util::log::type::ERROR
+        );
+
+        sys::file::close(this->file_descriptor);
+        this->file_descriptor = mmap::INTERNAL_ERROR_CODE;
+        return nullptr;
+    }
+
+    // Reserve twice the capacity, then place the same pages in both halves
+    address_type reserve_address = sys::memory::map
+    (
+        nullptr,
+        2 * this->ring_capacity_bytes,
+        PROT_NONE,
+        MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE,
+        -1,
+        0
+    );
+    if (reserve_address == MAP_FAILED)
+    {
+        util::log::record
+        (
+            "Unable to reserve address range for ring buffer",
+            util::log::type::ERROR
+        );
+
+        sys::file::close(this->file_descriptor);
+        this->file_descriptor = mmap::INTERNAL_ERROR_CODE;
+        return nullptr;
+    }
+
+    std::uint8_t *ring_address = static_cast<std::uint8_t *>(reserve_address);
+    for (size_type view = 0; view < 2; ++view)
+    {
+        address_type view_address = sys::memory::map
+        (
+            ring_address + view * this->ring_capacity_bytes,
+            this->ring_capacity_bytes,
+            PROT_READ | PROT_WRITE,
+            MAP_SHARED | MAP_FIXED,
+            this->file_descriptor,
+            page_size
+        );
+        if (view_address == MAP_FAILED)
+        {
+            util::log::record
+            (
+                "Unable to map ring buffer view",
+                util::log::type::ERROR
+            );
+
+            sys::memory::unmap(reserve_address, 2 * this->ring_capacity_bytes);
+            sys::file::close(this->file_descriptor);
+            this->file_descriptor = mmap::INTERNAL_ERROR_CODE;
+            return nullptr;
+        }
+    }
+
+    // Map cursors
+    address_type cursor_address = sys::memory::map
+    (
+        nullptr,
+        page_size,
+        PROT_READ | PROT_WRITE,
+        MAP_SHARED,
+        this->file_descriptor,
+        0
+    );
+    if (cursor_address == MAP_FAILED)
+    {
+        util::log::record
+        (
+            "Unable to map ring buffer cursors",
+            util::log::type::ERROR
+        );
+
+        sys::memory::unmap(reserve_address, 2 * this->ring_capacity_bytes);
+        sys::file::close(this->file_descriptor);
+        this->file_descriptor = mmap::INTERNAL_ERROR_CODE;
+        return nullptr;
+    }
+
+    this->ring_address = ring_address;
+    this->cursors      = static_cast<ring_cursors *>(cursor_address);
+
+    return this->ring_address;
+}
+
+mmap::status_code
+mmap::ring_buffer::flush() noexcept
+{
+    // Check if mapped
+    if (!this->ring_address)
+    {
+        util::log::record
+        (
+            "Ring buffer is not yet mapped",
+            util::log::type::ERROR
+        );
+
+        return mmap::EXTERNAL_ERROR_CODE;
+    }
+
+    // Data first; cursors then never point past persisted bytes
+    sys::memory::status_code data_status = sys::memory::sync
+    (
+        this->ring_address,
+        this->ring_capacity_bytes,
+        MS_SYNC
+    );
+    sys::memory::status_code cursor_status = sys::memory::sync
+    (
+        this->cursors,
+        sys::memory::page_size,
+        MS_SYNC
+    );
+    if (data_status == mmap::INTERNAL_ERROR_CODE || cursor_status == mmap::INTERNAL_ERROR_CODE)
+    {
+        util::log::record
+        (
+            "Unable to synchronize ring buffer to backing",
+            util::log::type::ERROR
+        );
+
+        return mmap::EXTERNAL_ERROR_CODE;
+    }
+
+    return mmap::GLOBAL_SUCCESS_CODE;
+}
+
+mmap::status_code
+mmap::ring_buffer::close() noexcept
+{
+    // Check if mapped
+    if (!this->ring_address)
+    {
+        util::log::record
+        (
+            "Ring buffer is not yet mapped",
+            util::log::type::ERROR
+        );
+
+        return mmap::EXTERNAL_ERROR_CODE;
+    }
+
+    // One unmap covers both views
+    sys::memory::status_code ring_status = sys::memory::unmap
+    (
+        this->ring_address,
+        2 * this->ring_capacity_bytes
+    );
+    sys::memory::status_code cursor_status = sys::memory::unmap
+    (
+        this->cursors,
+        sys::memory::page_size
+    );
+    sys::file::close(this->file_descriptor);
+
+    this->ring_address    = nullptr;
+    this->cursors         = nullptr;
+    this->file_descriptor = mmap::INTERNAL_ERROR_CODE;
+
+    if (ring_status == mmap::INTERNAL_ERROR_CODE || cursor_status == mmap::INTERNAL_ERROR_CODE)
+    {
+        util::log::record
+        (
+            "Unable to unmap ring buffer",
+            util::log::type::ERROR
+        );
+
+        return mmap::EXTERNAL_ERROR_CODE;
+    }
+
+    return mmap::GLOBAL_SUCCESS_CODE;
+}
+
+
+mmap::address_type
+mmap::ring_buffer::address() const noexcept
+{
+    return this->ring_address;
+}
+
+mmap::size_type
+mmap::ring_buffer::capacity() const noexcept
+{
+    return this->ring_capacity_bytes;
+}
+
+sys::file::descriptor
+mmap::ring_buffer::descriptor() const noexcept
+{
+    return this->file_descriptor;
+}
+
+
+mmap::size_type
+mmap::ring_buffer::size() const noexcept
+{
+    if (!this->cursors)
+        return 0;
+
+    const std::uint64_t tail = this->cursors->tail.load(std::memory_order_acquire);
+    const std::uint64_t head = this->cursors->head.load(std::memory_order_acquire);
+
+    return head - tail;
+}
+
+mmap::size_type
+mmap::ring_buffer::space() const noexcept
+{
+    if (!this->cursors)
+        return 0;
+
+    return this->ring_capacity_bytes - this->size();
+}
+
+std::uint8_t *
+mmap::ring_buffer::write_span
+(
+    size_type &available
+) const noexcept
+{
+    if (!this->cursors)
+    {
+        available = 0;
+        return nullptr;
+    }
+
+    // Producer owns head; tail acquired to see released bytes
+    const std::uint64_t head = this->cursors->head.load(std::memory_order_relaxed);
+    const std::uint64_t tail = this->cursors->tail.load(std::memory_order_acquire);
+    available = this->ring_capacity_bytes - (head - tail);
+
+    return this->ring_address + head % this->ring_capacity_bytes;
+}
+
+mmap::status_code
+mmap::ring_buffer::commit
+(
+    const size_type length
+) noexcept
+{
+    if (!this->cursors || length > this->space())
+    {
+        util::log::record
+        (
+            "Ring buffer commit exceeds free space",
+            util::log::type::ERROR
+        );
+
+        return mmap::EXTERNAL_ERROR_CODE;
+    }
+
+    // Release publishes written bytes to consumer
+    this->cursors->head.fetch_add(length, std::memory_order_release);
+
+    return mmap::GLOBAL_SUCCESS_CODE;
+}
+
+const std::uint8_t *
+mmap::ring_buffer::read_span
+(
+    size_type &available
+) const noexcept
+{
+    if (!this->cursors)
+    {
+        available = 0;
+        return nullptr;
+    }
+
+    // Consumer owns tail; head acquired to see published bytes
+    const std::uint64_t tail = this->cursors->tail.load(std::memory_order_relaxed);
+    const std::uint64_t head = this->cursors->head.load(std::memory_order_acquire);
+    available = head - tail;
+
+    return this->ring_address + tail % this->ring_capacity_bytes;
+}
+
+mmap::status_code
+mmap::ring_buffer::consume
+(
+    const size_type length
+) noexcept
+{
+    if (!this->cursors || length > this->size())
+    {
+        util::log::record
+        (
+            "Ring buffer consume exceeds readable bytes",
+            util::log::type::ERROR
+        );
+
+        return mmap::EXTERNAL_ERROR_CODE;
+    }
+
+    // Release hands bytes back to producer only after they were read
+    this->cursors->tail.fetch_add(length, std::memory_order_release);
+
+    return mmap::GLOBAL_SUCCESS_CODE;
+}
@@ -0,0 +1,142 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+#include "file/file.hpp"
+
+
+namespace mmap
+{
+
+// Monotonic byte positions shared by producer and consumer; kept on
+// separate lines so the two sides do not contend
+struct ring_cursors
+{
+    alignas(64) std::atomic<std::uint64_t> head;
+    alignas(64) std::atomic<std::uint64_t> tail;
+};
+
+// Single-producer, single-consumer byte ring whose data region is mapped
+// twice back to back, so any window up to capacity is one contiguous span;
+// backing is an anonymous memfd, or a file when a path is given, with the
+// cursors in its first page
+class ring_buffer
+{
+private:
+    // User provided ring metadata
+    std::string           file_path;
+    size_type             ring_capacity_bytes;
+
+    // Internal ring metadata
+    std::uint8_t         *ring_address    = nullptr;
+    ring_cursors         *cursors         = nullptr;
+    sys::file::descriptor file_descriptor = mmap::INTERNAL_ERROR_CODE;
+
+public:
+    ring_buffer
+    (
+        // Required parameters
+        const size_type    ring_capacity,
+
+        // Advanced parameters
+        const std::string &file_path = ""
+    );
+
+    virtual ~ring_buffer() noexcept;
+
+    // No copies permitted
+    ring_buffer(const ring_buffer &other)           = delete;
+    ring_buffer operator=(const ring_buffer &other) = delete;
+
+    address_type
+    virtual open() noexcept;
+    status_code
+    virtual flush() noexcept;
+    status_code
+    virtual close() noexcept;
+
+    address_type
+    address() const noexcept;
+    size_type
+    capacity() const noexcept;
+    sys::file::descriptor
+    descriptor() const noexcept;
+
+    // Bytes readable and writable now
+    size_type
+    size() const noexcept;
+    size_type
+    space() const noexcept;
+
+    // Producer side: contiguous free span at head, then publish written bytes
+    std::uint8_t *
+    write_span
+    (
+        size_type &available
+    ) const noexcept;
+    status_code
+    commit
+    (
+        const size_type length
+    ) noexcept;
+
+    // Consumer side: contiguous readable span at tail, then release bytes
+    const std::uint8_t *
+    read_span
+    (
+        size_type &available
+    ) const noexcept;
+    status_code
+    consume
+    (
+        const size_type length
+    ) noexcept;
+
+    // Typed views count whole elements; capacity should be a multiple of
+    // the element size so elements stay aligned across the wrap
+    template <typename data_type>
+    data_type *
+    write_view
+    (
+        size_type &count
+    ) const noexcept;
+    template <typename data_type>
+    const data_type *
+    read_view
+    (
+        size_type &count
+    ) const noexcept;
+};
+
+} // mmap namespace
+
+
+template <typename data_type>
+data_type *
+mmap::ring_buffer::write_view
+(
+    size_type &count
+) const noexcept
+{
+    size_type available = 0;
+    std::uint8_t *span  = this->write_span(available);
+    count = available / sizeof(data_type);
+
+    return reinterpret_cast<data_type *>(span);
+}
+
+template <typename data_type>
+const data_type *
+mmap::ring_buffer::read_view
+(
+    size_type &count
+) const noexcept
+{
+    size_type available      = 0;
+    const std::uint8_t *span = this->read_span(available);
+    count = available / sizeof(data_type);
+
+    return reinterpret_cast<const data_type *>(span);
+}
@@ -0,0 +1,146 @@
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "seqlock_file.hpp"
+
+
+namespace
+{
+
+// One cache line; every word carries the same value so a torn copy shows
+struct payload
+{
+    std::array<std::uint64_t, 8> words;
+};
+
+// Whole when every word matches the first
+bool
+whole
+(
+    const payload &value
+)
+{
+    for (const std::uint64_t word: value.words)
+    {
+        if (word != value.words[0])
+            return false;
+    }
+
+    return true;
+}
+
+} // anonymous namespace
+
+
+/**
+ *  @brief Seqlock Benchmark
+ *
+ *  @details Run one writer storing to a seqlock file while reader threads
+ *  load from it, then report reads and writes per second and the number
+ *  of torn reads observed, which must be zero.
+ *
+ *  Usage: seqlock_bench <file> [readers] [seconds] [elements]
+ */
+int
+main
+(
+    int    argc,
+    char **argv
+)
+{
+    if (argc < 2)
+    {
+        std::cerr << "Usage: " << argv[0] << " <file> [readers] [seconds] [elements]" << std::endl;
+        return EXIT_FAILURE;
+    }
+    const std::size_t readers  = argc > 2 ? std::stoul(argv[2]) : 4;
+    const std::size_t seconds  = argc > 3 ? std::stoul(argv[3]) : 5;
+    const std::size_t elements = argc > 4 ? std::stoul(argv[4]) : 1024;
+    if (!readers || !seconds || !elements)
+    {
+        std::cerr << "Readers, seconds and elements must be non-zero" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    if (!mmap::file::valid_path(argv[1]))
+    {
+        std::cerr << "Parent directory of benchmark file does not exist: " << argv[1] << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    mmap::seqlock_file<payload> records(argv[1], elements);
+    if (!records.open())
+    {
+        std::cerr << "Unable to open benchmark file: " << argv[1] << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::atomic<bool>          running{true};
+    std::atomic<std::uint64_t> reads{0};
+    std::atomic<std::uint64_t> torn{0};
+    std::uint64_t              writes = 0;
+
+    std::vector<std::thread> workers;
+    for (std::size_t reader = 0; reader < readers; ++reader)
+    {
+        workers.emplace_back
+        (
+            [&records, &running, &reads, &torn, elements, reader]()
+            {
+                std::uint64_t local_reads = 0;
+                std::uint64_t local_torn  = 0;
+                std::size_t   index       = reader;
+                while (running.load(std::memory_order_relaxed))
+                {
+                    if (!whole(records.load(index)))
+                        ++local_torn;
+
+                    ++local_reads;
+                    index = index + 1 == elements ? 0 : index + 1;
+                }
+
+                reads.fetch_add(local_reads, std::memory_order_relaxed);
+                torn.fetch_add(local_torn, std::memory_order_relaxed);
+            }
+        );
+    }
+
+    // Single writer on this thread until time is up
+    const auto start    = std::chrono::steady_clock::now();
+    const auto deadline = start + std::chrono::seconds(seconds);
+    payload    value;
+    for (std::size_t index = 0; ; index = index + 1 == elements ? 0 : index + 1)
+    {
+        value.words.fill(writes);
+        records.store(index, value);
+        ++writes;
+
+        if ((writes & 0xfff) == 0 && std::chrono::steady_clock::now() >= deadline)
+            break;
+    }
+    running.store(false, std::memory_order_relaxed);
+
+    for (std::thread &worker: workers)
+        worker.join();
+
+    const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    records.close();
+
+    std::cout << std::fixed << std::setprecision(0)
+        << "readers "      << readers
+        << "  elements "   << elements
+        << "  element "    << sizeof(payload) << " B\n"
+        << "reads/sec "    << reads.load() / elapsed
+        << "  writes/sec " << writes / elapsed
+        << "  torn reads " << torn.load() << std::endl;
+
+    return torn.load() ? EXIT_FAILURE : EXIT_SUCCESS;
+}
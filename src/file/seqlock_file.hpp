@@ -0,0 +1,65 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+
+#include "file/ordered_file.hpp"
+
+
+namespace mmap
+{
+
+// Element paired with a sequence counter; odd while a write is in flight
+template <typename data_type>
+struct sequenced
+{
+    std::atomic<std::uint64_t> sequence;
+    data_type                  value;
+
+    void
+    store
+    (
+        const data_type &value
+    ) noexcept;
+
+    data_type
+    load() const noexcept;
+    bool
+    try_load
+    (
+        data_type &value
+    ) const noexcept;
+};
+
+// Single-writer, multi-reader mapping; readers in any process see whole
+// elements without locks or system calls
+template <typename data_type>
+class seqlock_file: public ordered_file<sequenced<data_type>>
+{
+public:
+    using ordered_file<sequenced<data_type>>::ordered_file;
+
+    void
+    store
+    (
+        const size_type  index,
+        const data_type &value
+    ) noexcept;
+
+    data_type
+    load
+    (
+        const size_type index
+    ) const noexcept;
+    bool
+    try_load
+    (
+        const size_type  index,
+        data_type       &value
+    ) const noexcept;
+};
+
+} // mmap namespace
+
+#include "file/seqlock_file.tpp"
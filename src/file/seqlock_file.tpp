@@ -0,0 +1,97 @@
+#include <cstring>
+
+
+template <typename data_type>
+void
+mmap::sequenced<data_type>::store
+(
+    const data_type &value
+) noexcept
+{
+    static_assert
+    (
+        std::is_trivially_copyable_v<data_type>,
+        "Sequenced elements must be trivially copyable"
+    );
+    static_assert
+    (
+        std::atomic<std::uint64_t>::is_always_lock_free,
+        "Sequence counter must be lock free to be shared across processes"
+    );
+
+    // Odd sequence marks write in progress
+    const std::uint64_t sequence = this->sequence.load(std::memory_order_relaxed);
+    this->sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    std::memcpy(&this->value, &value, sizeof(data_type));
+
+    this->sequence.store(sequence + 2, std::memory_order_release);
+}
+
+template <typename data_type>
+data_type
+mmap::sequenced<data_type>::load() const noexcept
+{
+    data_type value;
+    while (!this->try_load(value))
+    {
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+#endif
+    }
+
+    return value;
+}
+
+template <typename data_type>
+bool
+mmap::sequenced<data_type>::try_load
+(
+    data_type &value
+) const noexcept
+{
+    const std::uint64_t before = this->sequence.load(std::memory_order_acquire);
+    if (before & 1)
+        return false;
+
+    std::memcpy(&value, &this->value, sizeof(data_type));
+    std::atomic_thread_fence(std::memory_order_acquire);
+
+    // Unchanged even sequence means no write overlapped the copy
+    const std::uint64_t after = this->sequence.load(std::memory_order_relaxed);
+    return before == after;
+}
+
+
+template <typename data_type>
+void
+mmap::seqlock_file<data_type>::store
+(
+    const size_type  index,
+    const data_type &value
+) noexcept
+{
+    (*this)[index].store(value);
+}
+
+template <typename data_type>
+data_type
+mmap::seqlock_file<data_type>::load
+(
+    const size_type index
+) const noexcept
+{
+    return (*this)[index].load();
+}
+
+template <typename data_type>
+bool
+mmap::seqlock_file<data_type>::try_load
+(
+    const size_type  index,
+    data_type       &value
+) const noexcept
+{
+    return (*this)[index].try_load(value);
+}
@@ -0,0 +1,344 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+#include <util/record.hpp>
+
+#include "snapshot.hpp"
+
+
+namespace
+{
+
+// Kernel page table export; one 64-bit entry per virtual page
+constexpr char PAGEMAP_PATH[] = "/proc/self/pagemap";
+
+constexpr std::uint64_t PAGEMAP_PRESENT   = std::uint64_t(1) << 63;
+constexpr std::uint64_t PAGEMAP_SWAPPED   = std::uint64_t(1) << 62;
+constexpr std::uint64_t PAGEMAP_FILE_PAGE = std::uint64_t(1) << 61;
+
+// Page table entries read per call
+constexpr mmap::size_type PAGEMAP_CHUNK = 512;
+
+} // anonymous namespace
+
+
+mmap::snapshot::snapshot
+(
+    // Required parameters
+    file                         &origin,
+
+    // System call flags
+    const sys::memory::flag_code  protocol_flag
+):  origin(origin)
+{
+    // Validate origin mapping
+    if (!origin.address())
+    {
+        util::log::record
+        (
+            "Snapshot origin is not mapped: "
+            "open the file before taking a snapshot",
+            util::log::type::ABORT
+        );
+
+        throw std::runtime_error("Provided snapshot origin is not mapped");
+    }
+
+    // metadata
+    this->snapshot_address        = nullptr;
+    this->snapshot_capacity_bytes = origin.capacity();
+
+    // flags
+    this->protocol_flag = protocol_flag;
+}
+
+mmap::snapshot::~snapshot() noexcept
+{
+    if (this->snapshot_address)
+        this->close();
+}
+
+
+mmap::address_type
+mmap::snapshot::open() noexcept
+{
+    // Check if mapped
+    if (this->snapshot_address)
+    {
+        util::log::record
+        (
+            "Snapshot is already mapped; "
+            "call rollback to discard private changes",
+            util::log::type::ERROR
+        );
+
+        return nullptr;
+    }
+
+    // Check origin is still mapped
+    if (!this->origin.address())
+    {
+        util::log::record
+        (
+            "Snapshot origin is no longer mapped",
+            util::log::type::ERROR
+        );
+
+        return nullptr;
+    }
+    this->snapshot_capacity_bytes = this->origin.capacity();
+
+    // Map file privately; writes are copied on write and never reach file
+    address_type snapshot_address = sys::memory::map
+    (
+        nullptr,
+        this->snapshot_capacity_bytes,
+        this->protocol_flag,
+        MAP_PRIVATE,
+        this->origin.descriptor(),
+        this->origin.offset()
+    );
+    if (snapshot_address == MAP_FAILED)
+    {
+        util::log::record
+        (
+            "Unable to allocate a private mapping from a snapshot address to file",
+            util::log::type::ERROR
+        );
+
+        return nullptr;
+    }
+    this->snapshot_address = snapshot_address;
+
+    return this->snapshot_address;
+}
+
+
+mmap::status_code
+mmap::snapshot::commit() noexcept
+{
+    // Check if mapped
+    if (!this->snapshot_address || !this->origin.address())
+    {
+        util::log::record
+        (
+            "Snapshot or origin memory is not yet mapped",
+            util::log::type::ERROR
+        );
+
+        return mmap::EXTERNAL_ERROR_CODE;
+    }
+
+    // Origin remapped smaller would leave dirty pages nowhere to go
+    if (this->origin.capacity() < this->snapshot_capacity_bytes)
+    {
+        util::log::record
+        (
+            "Origin is smaller than snapshot; unable to commit",
+            util::log::type::ERROR
+        );
+
+        return mmap::EXTERNAL_ERROR_CODE;
+    }
+
+    // Collect pages written through the snapshot
+    std::vector<size_type> pages;
+    mmap::status_code dirty_status = this->dirty_pages(pages);
+    if (dirty_status == mmap::EXTERNAL_ERROR_CODE)
+    {
+        util::log::record
+        (
+            "Unable to determine modified pages of snapshot",
+            util::log::type::ERROR
+        );
+
+        return mmap::EXTERNAL_ERROR_CODE;
+    }
+
+    // Copy runs of consecutive dirty pages into shared mapping
+    const size_type page_size = sys::memory::page_size;
+    std::uint8_t *source      = static_cast<std::uint8_t *>(this->snapshot_address);
+    std::uint8_t *destination = static_cast<std::uint8_t *>(this->origin.address());
+    for (size_type index = 0; index < pages.size();)
+    {
+        size_type first = pages[index];
+        size_type count = 1;
+        while (index + count < pages.size() && pages[index + count] == first + count)
+            ++count;
+
+        size_type start  = first * page_size;
+        size_type length = count * page_size;
+        if (start + length > this->snapshot_capacity_bytes)
+            length = this->snapshot_capacity_bytes - start;
+
+        std::memcpy(destination + start, source + start, length);
+        index += count;
+    }
+
+    // Private copies now match shared pages
+    return this->rollback();
+}
+
+mmap::status_code
+mmap::snapshot::rollback() noexcept
+{
+    // Check if mapped
+    if (!this->snapshot_address)
+    {
+        util::log::record
+        (
+            "Snapshot memory is not yet mapped",
+            util::log::type::ERROR
+        );
+
+        return mmap::EXTERNAL_ERROR_CODE;
+    }
+
+    // Drop private copies; next access faults in shared file pages
+    sys::memory::status_code advise_status = sys::memory::advise
+    (
+        this->snapshot_address,
+        this->snapshot_capacity_bytes,
+        MADV_DONTNEED
+    );
+    if (advise_status == mmap::INTERNAL_ERROR_CODE)
+    {
+        util::log::record
+        (
+            "Unable to discard private pages of snapshot",
+            util::log::type::ERROR
+        );
+
+        return mmap::EXTERNAL_ERROR_CODE;
+    }
+
+    return mmap::GLOBAL_SUCCESS_CODE;
+}
+
+
+mmap::status_code
+mmap::snapshot::close() noexcept
+{
+    // Check if mapped
+    if (!this->snapshot_address)
+    {
+        util::log::record
+        (
+            "Snapshot memory is not yet mapped",
+            util::log::type::ERROR
+        );
+
+        return mmap::EXTERNAL_ERROR_CODE;
+    }
+
+    // Unmap snapshot, discarding uncommitted changes
+    sys::memory::status_code unmap_status = sys::memory::unmap
+    (
+        this->snapshot_address,
+        this->snapshot_capacity_bytes
+    );
+    if (unmap_status == mmap::INTERNAL_ERROR_CODE)
+    {
+        util::log::record
+        (
+            "Unable to unmap snapshot from snapshot address",
+            util::log::type::ERROR
+        );
+
+        return mmap::EXTERNAL_ERROR_CODE;
+    }
+    this->snapshot_address = nullptr;
+
+    return mmap::GLOBAL_SUCCESS_CODE;
+}
+
+
+mmap::address_type
+mmap::snapshot::address() const noexcept
+{
+    return this->snapshot_address;
+}
+
+
+mmap::status_code
+mmap::snapshot::dirty_pages
+(
+    std::vector<size_type> &pages
+) const noexcept
+{
+    const size_type page_size  = sys::memory::page_size;
+    const size_type page_count = (this->snapshot_capacity_bytes + page_size - 1) / page_size;
+    const size_type first_page = reinterpret_cast<size_type>(this->snapshot_address) / page_size;
+
+    // Open page table of this process
+    sys::file::descriptor pagemap_descriptor = sys::file::open
+    (
+        PAGEMAP_PATH,
+        O_RDONLY | O_CLOEXEC
+    );
+    if (pagemap_descriptor == mmap::INTERNAL_ERROR_CODE)
+    {
+        util::log::record
+        (
+            "Unable to open process page map",
+            util::log::type::ERROR
+        );
+
+        return mmap::EXTERNAL_ERROR_CODE;
+    }
+    pages.clear();
+
+    // Read page table entries for snapshot range a chunk at a time
+    std::uint64_t entries[PAGEMAP_CHUNK];
+    for (size_type done = 0; done < page_count; done += PAGEMAP_CHUNK)
+    {
+        const size_type entries_bytes = std::min(PAGEMAP_CHUNK, page_count - done)
+            * sizeof(std::uint64_t);
+        size_type       read_bytes    = 0;
+        while (read_bytes < entries_bytes)
+        {
+            ssize_t read_status = sys::file::read
+            (
+                pagemap_descriptor,
+                reinterpret_cast<std::uint8_t *>(entries) + read_bytes,
+                entries_bytes - read_bytes,
+                (first_page + done) * sizeof(std::uint64_t) + read_bytes
+            );
+            if (read_status <= 0)
+            {
+                util::log::record
+                (
+                    "Unable to read process page map",
+                    util::log::type::ERROR
+                );
+
+                sys::file::close(pagemap_descriptor);
+                return mmap::EXTERNAL_ERROR_CODE;
+            }
+            read_bytes += static_cast<size_type>(read_status);
+        }
+
+        // Private anonymous pages are the copied-on-write ones
+        try
+        {
+            for (size_type entry = 0; entry < entries_bytes / sizeof(std::uint64_t); ++entry)
+            {
+                if ((entries[entry] & (PAGEMAP_PRESENT | PAGEMAP_SWAPPED))
+                    && !(entries[entry] & PAGEMAP_FILE_PAGE))
+                    pages.push_back(done + entry);
+            }
+        }
+
+        catch (const std::exception &exception)
+        {
+            sys::file::close(pagemap_descriptor);
+            return mmap::EXTERNAL_ERROR_CODE;
+        }
+    }
+    sys::file::close(pagemap_descriptor);
+
+    return mmap::GLOBAL_SUCCESS_CODE;
+}
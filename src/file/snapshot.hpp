@@ -0,0 +1,63 @@
+#pragma once
+
+#include <vector>
+
+#include "file/file.hpp"
+
+
+namespace mmap
+{
+
+class snapshot
+{
+protected:
+    // Shared mapping the snapshot is taken from
+    file         &origin;
+
+    // Internal snapshot metadata
+    address_type  snapshot_address;
+    size_type     snapshot_capacity_bytes;
+
+    // Mapping flags
+    sys::memory::flag_code protocol_flag = PROT_READ | PROT_WRITE;
+
+public:
+    snapshot
+    (
+        // Required parameters
+        file                         &origin,
+
+        // System call flags
+        const sys::memory::flag_code  protocol_flag = PROT_READ | PROT_WRITE
+    );
+
+    virtual ~snapshot() noexcept;
+
+    // No copies permitted
+    snapshot(const snapshot &other)           = delete;
+    snapshot operator=(const snapshot &other) = delete;
+
+    address_type
+    address() const noexcept;
+
+    address_type
+    virtual open() noexcept;
+
+    // Fails if origin was remapped smaller than the snapshot
+    status_code
+    virtual commit() noexcept;
+    status_code
+    virtual rollback() noexcept;
+
+    status_code
+    virtual close() noexcept;
+
+protected:
+    status_code
+    dirty_pages
+    (
+        std::vector<size_type> &pages
+    ) const noexcept;
+};
+
+} // mmap namespace
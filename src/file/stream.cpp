@@ -0,0 +1,278 @@
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#if defined(__x86_64__)
+#include <emmintrin.h>
+#endif
+
+#include <util/pool.hpp>
+#include <util/record.hpp>
+
+#include "stream.hpp"
+
+
+namespace
+{
+
+// Cache resident staging per worker for fill and generate
+constexpr mmap::size_type STAGING_BYTES = 64 << 10;
+
+// Per-thread ranges start at multiples of this many bytes from the
+// destination when unit size divides it; page aligned only when the
+// destination is
+constexpr mmap::size_type SPLIT_ALIGN_BYTES = 4096;
+
+// Store bypassing caches: aligned 16-byte streaming stores, cached edges;
+// caller fences once its range is done
+void
+stream_store
+(
+    std::uint8_t       *destination,
+    const std::uint8_t *source,
+    mmap::size_type     length
+) noexcept
+{
+#if defined(__x86_64__)
+    const mmap::size_type head = std::min<mmap::size_type>
+    (
+        length,
+        (16 - reinterpret_cast<std::uintptr_t>(destination) % 16) % 16
+    );
+    std::memcpy(destination, source, head);
+    destination += head;
+    source      += head;
+    length      -= head;
+
+    while (length >= 64)
+    {
+        const __m128i first  = _mm_loadu_si128(reinterpret_cast<const __m128i *>(source));
+        const __m128i second = _mm_loadu_si128(reinterpret_cast<const __m128i *>(source + 16));
+        const __m128i third  = _mm_loadu_si128(reinterpret_cast<const __m128i *>(source + 32));
+        const __m128i fourth = _mm_loadu_si128(reinterpret_cast<const __m128i *>(source + 48));
+        _mm_stream_si128(reinterpret_cast<__m128i *>(destination),      first);
+        _mm_stream_si128(reinterpret_cast<__m128i *>(destination + 16), second);
+        _mm_stream_si128(reinterpret_cast<__m128i *>(destination + 32), third);
+        _mm_stream_si128(reinterpret_cast<__m128i *>(destination + 48), fourth);
+
+        destination += 64;
+        source      += 64;
+        length      -= 64;
+    }
+    std::memcpy(destination, source, length);
+#else
+    std::memcpy(destination, source, length);
+#endif
+}
+
+// Streaming stores are weakly ordered
+inline void
+stream_fence() noexcept
+{
+#if defined(__x86_64__)
+    _mm_sfence();
+#endif
+}
+
+// Split units into one contiguous range per worker and run job on each
+template <typename job_type>
+mmap::status_code
+parallel
+(
+    const mmap::size_type  units,
+    const mmap::size_type  unit_bytes,
+    const mmap::size_type  thread_count,
+    job_type             &&job
+) noexcept
+{
+    std::atomic<bool> failed{false};
+    auto guarded = [&job, &failed](const mmap::size_type first, const mmap::size_type last)
+    {
+        try
+        {
+            job(first, last);
+        }
+
+        // Producers are user code and may throw anything
+        catch (...)
+        {
+            failed.store(true, std::memory_order_relaxed);
+        }
+    };
+
+    const mmap::size_type workers = std::max<mmap::size_type>(1, std::min(thread_count, units));
+    if (workers == 1)
+    {
+        guarded(0, units);
+        return failed ? mmap::EXTERNAL_ERROR_CODE : mmap::GLOBAL_SUCCESS_CODE;
+    }
+
+    // Ranges rounded to 4 KiB from destination when unit size permits
+    mmap::size_type stride = (units + workers - 1) / workers;
+    if (SPLIT_ALIGN_BYTES % unit_bytes == 0)
+    {
+        const mmap::size_type align_units = SPLIT_ALIGN_BYTES / unit_bytes;
+        stride = (stride + align_units - 1) / align_units * align_units;
+    }
+
+    try
+    {
+        util::thread::pool pool(workers);
+        for (mmap::size_type first = 0; first < units; first += stride)
+        {
+            const mmap::size_type last = std::min(first + stride, units);
+            if (!pool.submit([&guarded, first, last]() { guarded(first, last); }))
+                failed.store(true, std::memory_order_relaxed);
+        }
+        pool.wait();
+    }
+
+    catch (...)
+    {
+        util::log::record
+        (
+            "Unable to start stream workers",
+            util::log::type::ERROR
+        );
+
+        return mmap::EXTERNAL_ERROR_CODE;
+    }
+
+    return failed ? mmap::EXTERNAL_ERROR_CODE : mmap::GLOBAL_SUCCESS_CODE;
+}
+
+} // anonymous namespace
+
+
+mmap::status_code
+mmap::stream::copy
+(
+    void            *destination,
+    const void      *source,
+    const size_type  length,
+    const size_type  thread_count
+) noexcept
+{
+    std::uint8_t       *target = static_cast<std::uint8_t *>(destination);
+    const std::uint8_t *origin = static_cast<const std::uint8_t *>(source);
+
+    return parallel
+    (
+        length,
+        1,
+        thread_count,
+        [target, origin](const size_type first, const size_type last)
+        {
+            if (last - first < STREAM_THRESHOLD_BYTES)
+            {
+                std::memcpy(target + first, origin + first, last - first);
+                return;
+            }
+
+            stream_store(target + first, origin + first, last - first);
+            stream_fence();
+        }
+    );
+}
+
+mmap::status_code
+mmap::stream::fill
+(
+    void            *destination,
+    const size_type  length,
+    const void      *pattern,
+    const size_type  pattern_length,
+    const size_type  thread_count
+) noexcept
+{
+    if (!pattern_length || length % pattern_length)
+    {
+        util::log::record
+        (
+            "Fill length must be a multiple of pattern length",
+            util::log::type::ERROR
+        );
+
+        return mmap::EXTERNAL_ERROR_CODE;
+    }
+
+    std::uint8_t *target = static_cast<std::uint8_t *>(destination);
+
+    return parallel
+    (
+        length / pattern_length,
+        pattern_length,
+        thread_count,
+        [target, pattern, pattern_length](const size_type first, const size_type last)
+        {
+            // Staging holds whole patterns so every copy stays in phase
+            const size_type repeats = std::max<size_type>(1, STAGING_BYTES / pattern_length);
+            std::vector<std::uint8_t> staging(repeats * pattern_length);
+            for (size_type repeat = 0; repeat < repeats; ++repeat)
+                std::memcpy(staging.data() + repeat * pattern_length, pattern, pattern_length);
+
+            // Whole range decides streaming, not each staging sized piece
+            const bool      streaming = (last - first) * pattern_length >= STREAM_THRESHOLD_BYTES;
+            const size_type end       = last * pattern_length;
+            for (size_type position = first * pattern_length; position < end;)
+            {
+                const size_type length = std::min<size_type>(staging.size(), end - position);
+                if (streaming)
+                    stream_store(target + position, staging.data(), length);
+                else
+                    std::memcpy(target + position, staging.data(), length);
+
+                position += length;
+            }
+
+            if (streaming)
+                stream_fence();
+        }
+    );
+}
+
+mmap::status_code
+mmap::stream::generate
+(
+    void                *destination,
+    const size_type      count,
+    const size_type      element_size,
+    const producer_type &producer,
+    const size_type      thread_count
+) noexcept
+{
+    if (!element_size)
+        return mmap::EXTERNAL_ERROR_CODE;
+
+    std::uint8_t *target = static_cast<std::uint8_t *>(destination);
+
+    return parallel
+    (
+        count,
+        element_size,
+        thread_count,
+        [target, element_size, &producer](const size_type first, const size_type last)
+        {
+            const size_type chunk = std::max<size_type>(1, STAGING_BYTES / element_size);
+            std::vector<std::uint8_t> staging(chunk * element_size);
+
+            // Staging is small; judge streaming on the whole range
+            const bool streaming = (last - first) * element_size >= STREAM_THRESHOLD_BYTES;
+            for (size_type index = first; index < last; index += chunk)
+            {
+                const size_type elements = std::min(chunk, last - index);
+                producer(index, elements, staging.data());
+
+                if (streaming)
+                    stream_store(target + index * element_size, staging.data(), elements * element_size);
+                else
+                    std::memcpy(target + index * element_size, staging.data(), elements * element_size);
+            }
+
+            if (streaming)
+                stream_fence();
+        }
+    );
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <functional>
+
+#include "file/file.hpp"
+
+
+namespace mmap
+{
+
+namespace stream
+{
+
+// Ranges per thread below this are written through the cache
+constexpr size_type STREAM_THRESHOLD_BYTES = 1 << 20;
+
+// Fills staging with count elements starting at element index
+using producer_type = std::function<void(size_type index, size_type count, void *staging)>;
+
+// Copy source into destination across threads; large ranges bypass caches
+status_code
+copy
+(
+    void            *destination,
+    const void      *source,
+    const size_type  length,
+    const size_type  thread_count = 1
+) noexcept;
+
+// Repeat pattern over destination; length is a multiple of pattern length
+status_code
+fill
+(
+    void            *destination,
+    const size_type  length,
+    const void      *pattern,
+    const size_type  pattern_length,
+    const size_type  thread_count = 1
+) noexcept;
+
+// Write count elements produced chunk by chunk into cache resident staging
+status_code
+generate
+(
+    void                *destination,
+    const size_type      count,
+    const size_type      element_size,
+    const producer_type &producer,
+    const size_type      thread_count = 1
+) noexcept;
+
+} // stream namespace
+
+} // mmap namespace
@@ -0,0 +1,212 @@
+#pragma once
+
+#include <array>
+#include <iterator>
+#include <type_traits>
+
+#include "file/ordered_file.hpp"
+
+
+namespace mmap
+{
+
+// One tile of a tiled file; edge tiles are stored whole but only extent
+// elements along each dimension lie inside the grid
+template <typename data_type, size_type dimensions>
+class tile_view
+{
+public:
+    using index_type = std::array<size_type, dimensions>;
+
+private:
+    data_type  *tile_data;
+    index_type  tile_origin;
+    index_type  tile_extent;
+    index_type  tile_shape;
+
+public:
+    tile_view
+    (
+        data_type        *tile_data,
+        const index_type &tile_origin,
+        const index_type &tile_extent,
+        const index_type &tile_shape
+    ) noexcept;
+
+    data_type *
+    data() const noexcept;
+    size_type
+    size() const noexcept;
+
+    // Grid index of first element, and elements inside grid per dimension
+    const index_type &
+    origin() const noexcept;
+    const index_type &
+    extent() const noexcept;
+
+    // Index relative to tile origin
+    template <typename... index_types>
+    data_type &
+    operator()
+    (
+        const index_types... indices
+    ) const noexcept;
+
+    // Storage order, padding included
+    data_type *
+    begin() const noexcept;
+    data_type *
+    end() const noexcept;
+};
+
+// N-dimensional grid stored tile by tile, each tile row-major inside;
+// neighbours along every dimension share pages, so column, block and
+// stencil access fault in far fewer pages than a row-major layout
+template <typename data_type, size_type dimensions>
+class tiled_file: public ordered_file<data_type>
+{
+public:
+    using index_type = std::array<size_type, dimensions>;
+    using view_type  = tile_view<data_type, dimensions>;
+
+    // Visits tiles in storage order
+    class tile_iterator
+    {
+    private:
+        const tiled_file *grid;
+        size_type         tile_index;
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type        = view_type;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = void;
+        using reference         = view_type;
+
+        tile_iterator
+        (
+            const tiled_file *grid,
+            const size_type   tile_index
+        ) noexcept;
+
+        view_type
+        operator*() const noexcept;
+        tile_iterator &
+        operator++() noexcept;
+        bool
+        operator==
+        (
+            const tile_iterator &other
+        ) const noexcept;
+        bool
+        operator!=
+        (
+            const tile_iterator &other
+        ) const noexcept;
+    };
+
+    struct tile_range
+    {
+        tile_iterator first;
+        tile_iterator last;
+
+        tile_iterator
+        begin() const noexcept;
+        tile_iterator
+        end() const noexcept;
+    };
+
+private:
+    // User provided grid metadata
+    index_type grid_extent;
+    index_type tile_shape;
+
+    // Tile edges are powers of two: shift and mask split an index
+    index_type tile_shift;
+    index_type tile_mask;
+    index_type tiles_per_dimension;
+    size_type  tile_elements;
+    size_type  total_tiles;
+
+public:
+    tiled_file
+    (
+        // Required parameters
+        const std::string            &file_path,
+        const index_type             &grid_extent,
+
+        // Advanced parameters
+        const index_type             &tile_shape    = default_shape(),
+
+        // System call flags
+        const sys::file::flag_code    open_flag     = O_RDWR | O_CREAT,
+        const sys::file::flag_code    lock_flag     = LOCK_SH,
+        const sys::memory::flag_code  protocol_flag = PROT_READ | PROT_WRITE,
+        const sys::memory::flag_code  mapping_flag  = MAP_SHARED,
+        const sys::memory::flag_code  sync_flag     = MS_ASYNC,
+        const sys::memory::flag_code  remap_flag    = MREMAP_MAYMOVE,
+        const sys::file::flag_code    allocate_flag = mmap::NO_ALLOCATE
+    );
+
+    virtual ~tiled_file() noexcept = default;
+
+    // No copies permitted
+    tiled_file(const tiled_file &other)           = delete;
+    tiled_file operator=(const tiled_file &other) = delete;
+
+    // Power of two edges filling one page, split as evenly as possible
+    static index_type
+    default_shape() noexcept;
+
+    const index_type &
+    extent() const noexcept;
+    const index_type &
+    shape() const noexcept;
+
+    template <typename... index_types>
+    data_type &
+    operator()
+    (
+        const index_types... indices
+    ) const noexcept;
+    data_type &
+    at
+    (
+        const index_type &index
+    ) const noexcept;
+
+    // Storage position of grid index
+    size_type
+    position
+    (
+        const index_type &index
+    ) const noexcept;
+
+    size_type
+    tile_count() const noexcept;
+    view_type
+    tile
+    (
+        const size_type tile_index
+    ) const noexcept;
+    // Tile holding grid index
+    view_type
+    tile_at
+    (
+        const index_type &index
+    ) const noexcept;
+    tile_range
+    tiles() const noexcept;
+
+protected:
+    static size_type
+    capacity_for
+    (
+        const index_type &grid_extent,
+        const index_type &tile_shape
+    ) noexcept;
+};
+
+} // mmap namespace
+
+#include "file/tiled_file.tpp"
@@ -0,0 +1,384 @@
+#include <algorithm>
+#include <stdexcept>
+
+#include <util/record.hpp>
+
+
+template <typename data_type, mmap::size_type dimensions>
+mmap::tile_view<data_type, dimensions>::tile_view
+(
+    data_type        *tile_data,
+    const index_type &tile_origin,
+    const index_type &tile_extent,
+    const index_type &tile_shape
+) noexcept
+{
+    this->tile_data   = tile_data;
+    this->tile_origin = tile_origin;
+    this->tile_extent = tile_extent;
+    this->tile_shape  = tile_shape;
+}
+
+template <typename data_type, mmap::size_type dimensions>
+data_type *
+mmap::tile_view<data_type, dimensions>::data() const noexcept
+{
+    return this->tile_data;
+}
+
+template <typename data_type, mmap::size_type dimensions>
+mmap::size_type
+mmap::tile_view<data_type, dimensions>::size() const noexcept
+{
+    size_type elements = 1;
+    for (const size_type edge: this->tile_shape)
+        elements *= edge;
+
+    return elements;
+}
+
+template <typename data_type, mmap::size_type dimensions>
+const typename mmap::tile_view<data_type, dimensions>::index_type &
+mmap::tile_view<data_type, dimensions>::origin() const noexcept
+{
+    return this->tile_origin;
+}
+
+template <typename data_type, mmap::size_type dimensions>
+const typename mmap::tile_view<data_type, dimensions>::index_type &
+mmap::tile_view<data_type, dimensions>::extent() const noexcept
+{
+    return this->tile_extent;
+}
+
+template <typename data_type, mmap::size_type dimensions>
+template <typename... index_types>
+data_type &
+mmap::tile_view<data_type, dimensions>::operator()
+(
+    const index_types... indices
+) const noexcept
+{
+    static_assert
+    (
+        sizeof...(indices) == dimensions,
+        "Tile index must give one coordinate per dimension"
+    );
+
+    const index_type index = {static_cast<size_type>(indices)...};
+
+    size_type offset = 0;
+    for (size_type dimension = 0; dimension < dimensions; ++dimension)
+        offset = offset * this->tile_shape[dimension] + index[dimension];
+
+    return this->tile_data[offset];
+}
+
+template <typename data_type, mmap::size_type dimensions>
+data_type *
+mmap::tile_view<data_type, dimensions>::begin() const noexcept
+{
+    return this->tile_data;
+}
+
+template <typename data_type, mmap::size_type dimensions>
+data_type *
+mmap::tile_view<data_type, dimensions>::end() const noexcept
+{
+    return this->tile_data + this->size();
+}
+
+
+template <typename data_type, mmap::size_type dimensions>
+mmap::tiled_file<data_type, dimensions>::tile_iterator::tile_iterator
+(
+    const tiled_file *grid,
+    const size_type   tile_index
+) noexcept
+{
+    this->grid       = grid;
+    this->tile_index = tile_index;
+}
+
+template <typename data_type, mmap::size_type dimensions>
+typename mmap::tiled_file<data_type, dimensions>::view_type
+mmap::tiled_file<data_type, dimensions>::tile_iterator::operator*() const noexcept
+{
+    return this->grid->tile(this->tile_index);
+}
+
+template <typename data_type, mmap::size_type dimensions>
+typename mmap::tiled_file<data_type, dimensions>::tile_iterator &
+mmap::tiled_file<data_type, dimensions>::tile_iterator::operator++() noexcept
+{
+    ++this->tile_index;
+    return *this;
+}
+
+template <typename data_type, mmap::size_type dimensions>
+bool
+mmap::tiled_file<data_type, dimensions>::tile_iterator::operator==
+(
+    const tile_iterator &other
+) const noexcept
+{
+    return this->grid == other.grid && this->tile_index == other.tile_index;
+}
+
+template <typename data_type, mmap::size_type dimensions>
+bool
+mmap::tiled_file<data_type, dimensions>::tile_iterator::operator!=
+(
+    const tile_iterator &other
+) const noexcept
+{
+    return !(*this == other);
+}
+
+template <typename data_type, mmap::size_type dimensions>
+typename mmap::tiled_file<data_type, dimensions>::tile_iterator
+mmap::tiled_file<data_type, dimensions>::tile_range::begin() const noexcept
+{
+    return this->first;
+}
+
+template <typename data_type, mmap::size_type dimensions>
+typename mmap::tiled_file<data_type, dimensions>::tile_iterator
+mmap::tiled_file<data_type, dimensions>::tile_range::end() const noexcept
+{
+    return this->last;
+}
+
+
+template <typename data_type, mmap::size_type dimensions>
+mmap::tiled_file<data_type, dimensions>::tiled_file
+(
+    // Required parameters
+    const std::string            &file_path,
+    const index_type             &grid_extent,
+
+    // Advanced parameters
+    const index_type             &tile_shape,
+
+    // System call flags
+    const sys::file::flag_code    open_flag,
+    const sys::file::flag_code    lock_flag,
+    const sys::memory::flag_code  protocol_flag,
+    const sys::memory::flag_code  mapping_flag,
+    const sys::memory::flag_code  sync_flag,
+    const sys::memory::flag_code  remap_flag,
+    const sys::file::flag_code    allocate_flag
+):  ordered_file<data_type>
+    (
+        file_path,
+        capacity_for(grid_extent, tile_shape),
+        0,
+        nullptr,
+        open_flag,
+        lock_flag,
+        protocol_flag,
+        mapping_flag,
+        sync_flag,
+        remap_flag,
+        allocate_flag
+    )
+{
+    static_assert(dimensions > 0, "Tiled file needs at least one dimension");
+    static_assert
+    (
+        std::is_trivially_copyable_v<data_type>,
+        "Mapped grid elements must be trivially copyable"
+    );
+
+    // Validate grid and tile shape
+    for (size_type dimension = 0; dimension < dimensions; ++dimension)
+    {
+        const size_type edge = tile_shape[dimension];
+        if (!grid_extent[dimension] || !edge || (edge & (edge - 1)))
+        {
+            util::log::record
+            (
+                "Grid extents must be non-zero and tile edges powers of two",
+                util::log::type::ABORT
+            );
+
+            throw std::runtime_error("Provided grid or tile shape is invalid");
+        }
+    }
+
+    // metadata
+    this->grid_extent   = grid_extent;
+    this->tile_shape    = tile_shape;
+    this->tile_elements = 1;
+    this->total_tiles   = 1;
+    for (size_type dimension = 0; dimension < dimensions; ++dimension)
+    {
+        const size_type edge = tile_shape[dimension];
+
+        this->tile_shift[dimension]          = __builtin_ctzll(edge);
+        this->tile_mask[dimension]           = edge - 1;
+        this->tiles_per_dimension[dimension] = (grid_extent[dimension] + edge - 1) / edge;
+        this->tile_elements                 *= edge;
+        this->total_tiles                   *= this->tiles_per_dimension[dimension];
+    }
+}
+
+
+template <typename data_type, mmap::size_type dimensions>
+typename mmap::tiled_file<data_type, dimensions>::index_type
+mmap::tiled_file<data_type, dimensions>::default_shape() noexcept
+{
+    // Largest power of two element count fitting one page
+    const size_type page_elements = std::max<size_type>(1, sys::memory::page_size / sizeof(data_type));
+    size_type       bits          = 63 - __builtin_clzll(page_elements);
+
+    // Hand out bits from the innermost dimension outward
+    index_type shape;
+    shape.fill(1);
+    for (size_type dimension = dimensions - 1; bits; --bits)
+    {
+        shape[dimension] <<= 1;
+        dimension = dimension ? dimension - 1 : dimensions - 1;
+    }
+
+    return shape;
+}
+
+template <typename data_type, mmap::size_type dimensions>
+const typename mmap::tiled_file<data_type, dimensions>::index_type &
+mmap::tiled_file<data_type, dimensions>::extent() const noexcept
+{
+    return this->grid_extent;
+}
+
+template <typename data_type, mmap::size_type dimensions>
+const typename mmap::tiled_file<data_type, dimensions>::index_type &
+mmap::tiled_file<data_type, dimensions>::shape() const noexcept
+{
+    return this->tile_shape;
+}
+
+template <typename data_type, mmap::size_type dimensions>
+template <typename... index_types>
+data_type &
+mmap::tiled_file<data_type, dimensions>::operator()
+(
+    const index_types... indices
+) const noexcept
+{
+    static_assert
+    (
+        sizeof...(indices) == dimensions,
+        "Grid index must give one coordinate per dimension"
+    );
+
+    return this->at({static_cast<size_type>(indices)...});
+}
+
+template <typename data_type, mmap::size_type dimensions>
+data_type &
+mmap::tiled_file<data_type, dimensions>::at
+(
+    const index_type &index
+) const noexcept
+{
+    return this->data()[this->position(index)];
+}
+
+template <typename data_type, mmap::size_type dimensions>
+mmap::size_type
+mmap::tiled_file<data_type, dimensions>::position
+(
+    const index_type &index
+) const noexcept
+{
+    // Row-major over tiles, then row-major within the tile
+    size_type tile  = 0;
+    size_type inner = 0;
+    for (size_type dimension = 0; dimension < dimensions; ++dimension)
+    {
+        tile  = tile * this->tiles_per_dimension[dimension]
+            + (index[dimension] >> this->tile_shift[dimension]);
+        inner = (inner << this->tile_shift[dimension])
+            | (index[dimension] & this->tile_mask[dimension]);
+    }
+
+    return tile * this->tile_elements + inner;
+}
+
+template <typename data_type, mmap::size_type dimensions>
+mmap::size_type
+mmap::tiled_file<data_type, dimensions>::tile_count() const noexcept
+{
+    return this->total_tiles;
+}
+
+template <typename data_type, mmap::size_type dimensions>
+typename mmap::tiled_file<data_type, dimensions>::view_type
+mmap::tiled_file<data_type, dimensions>::tile
+(
+    const size_type tile_index
+) const noexcept
+{
+    // Tile coordinates from innermost dimension outward
+    index_type origin;
+    index_type extent;
+    size_type  remainder = tile_index;
+    for (size_type dimension = dimensions; dimension-- > 0;)
+    {
+        const size_type coordinate = remainder % this->tiles_per_dimension[dimension];
+        remainder /= this->tiles_per_dimension[dimension];
+
+        origin[dimension] = coordinate << this->tile_shift[dimension];
+        extent[dimension] = std::min
+        (
+            this->tile_shape[dimension],
+            this->grid_extent[dimension] - origin[dimension]
+        );
+    }
+
+    return view_type
+    (
+        this->data() + tile_index * this->tile_elements,
+        origin,
+        extent,
+        this->tile_shape
+    );
+}
+
+template <typename data_type, mmap::size_type dimensions>
+typename mmap::tiled_file<data_type, dimensions>::view_type
+mmap::tiled_file<data_type, dimensions>::tile_at
+(
+    const index_type &index
+) const noexcept
+{
+    return this->tile(this->position(index) / this->tile_elements);
+}
+
+template <typename data_type, mmap::size_type dimensions>
+typename mmap::tiled_file<data_type, dimensions>::tile_range
+mmap::tiled_file<data_type, dimensions>::tiles() const noexcept
+{
+    return {tile_iterator(this, 0), tile_iterator(this, this->total_tiles)};
+}
+
+
+template <typename data_type, mmap::size_type dimensions>
+mmap::size_type
+mmap::tiled_file<data_type, dimensions>::capacity_for
+(
+    const index_type &grid_extent,
+    const index_type &tile_shape
+) noexcept
+{
+    // Whole tiles, edge tiles padded; invalid shapes are rejected after
+    size_type capacity = 1;
+    for (size_type dimension = 0; dimension < dimensions; ++dimension)
+    {
+        const size_type edge = std::max<size_type>(1, tile_shape[dimension]);
+        capacity *= (grid_extent[dimension] + edge - 1) / edge * edge;
+    }
+
+    return std::max<size_type>(1, capacity);
+}
@@ -0,0 +1,233 @@
+#include <stdexcept>
+
+#include <util/record.hpp>
+
+#include "stream.hpp"
+#include "writer.hpp"
+
+
+mmap::stream_writer::stream_writer
+(
+    // Required parameters
+    file            &origin,
+
+    // Advanced parameters
+    const size_type  window_bytes,
+    const size_type  window_count
+):  origin(origin)
+{
+    // Validate origin mapping
+    if (!origin.address() || !(origin.mapping() & MAP_SHARED))
+    {
+        util::log::record
+        (
+            "Stream writer origin is not a shared mapping: "
+            "open the file before attaching a writer",
+            util::log::type::ABORT
+        );
+
+        throw std::runtime_error("Provided stream writer origin is not mapped");
+    }
+
+    // Windows are dropped from the mapping page by page
+    const size_type page_size = sys::memory::page_size;
+    if (!window_bytes || window_bytes % page_size || !window_count)
+    {
+        util::log::record
+        (
+            "Stream writer window must be a non-zero multiple of page size",
+            util::log::type::ABORT
+        );
+
+        throw std::runtime_error("Provided stream writer window is invalid");
+    }
+
+    // metadata
+    this->window_bytes = window_bytes;
+    this->window_count = window_count;
+}
+
+
+mmap::status_code
+mmap::stream_writer::write
+(
+    const void      *source,
+    const size_type  length
+) noexcept
+{
+    // Check if range lies within mapping
+    if (length > this->origin.capacity() - this->write_cursor)
+    {
+        util::log::record
+        (
+            "Stream write exceeds file capacity",
+            util::log::type::ERROR
+        );
+
+        return mmap::EXTERNAL_ERROR_CODE;
+    }
+
+    // Large writes bypass caches; the pages are dropped soon anyway
+    mmap::status_code copy_status = mmap::stream::copy
+    (
+        static_cast<std::uint8_t *>(this->origin.address()) + this->write_cursor,
+        source,
+        length
+    );
+    if (copy_status == mmap::EXTERNAL_ERROR_CODE)
+        return mmap::EXTERNAL_ERROR_CODE;
+
+    return this->advance(this->write_cursor + length);
+}
+
+mmap::status_code
+mmap::stream_writer::advance
+(
+    const size_type cursor
+) noexcept
+{
+    if (cursor < this->write_cursor || cursor > this->origin.capacity())
+    {
+        util::log::record
+        (
+            "Stream cursor must move forward within file capacity",
+            util::log::type::ERROR
+        );
+
+        return mmap::EXTERNAL_ERROR_CODE;
+    }
+    this->write_cursor = cursor;
+
+    // Queue writeback of each window the cursor has left
+    while (this->write_cursor - this->started >= this->window_bytes)
+    {
+        if (this->start_window(this->started, this->window_bytes) == mmap::EXTERNAL_ERROR_CODE)
+            return mmap::EXTERNAL_ERROR_CODE;
+        this->started += this->window_bytes;
+    }
+
+    // Throttle: wait on and drop the oldest windows past the in-flight limit
+    while (this->started - this->retired > this->window_count * this->window_bytes)
+    {
+        if (this->retire_window(this->retired, this->window_bytes) == mmap::EXTERNAL_ERROR_CODE)
+            return mmap::EXTERNAL_ERROR_CODE;
+        this->retired += this->window_bytes;
+    }
+
+    return mmap::GLOBAL_SUCCESS_CODE;
+}
+
+mmap::status_code
+mmap::stream_writer::finish() noexcept
+{
+    if (this->write_cursor == this->retired)
+        return mmap::GLOBAL_SUCCESS_CODE;
+
+    // Partial last window included
+    if (this->write_cursor > this->started)
+    {
+        if (this->start_window(this->started, this->write_cursor - this->started) == mmap::EXTERNAL_ERROR_CODE)
+            return mmap::EXTERNAL_ERROR_CODE;
+    }
+
+    if (this->retire_window(this->retired, this->write_cursor - this->retired) == mmap::EXTERNAL_ERROR_CODE)
+        return mmap::EXTERNAL_ERROR_CODE;
+
+    this->started = this->write_cursor;
+    this->retired = this->write_cursor;
+
+    return mmap::GLOBAL_SUCCESS_CODE;
+}
+
+
+mmap::size_type
+mmap::stream_writer::cursor() const noexcept
+{
+    return this->write_cursor;
+}
+
+mmap::size_type
+mmap::stream_writer::dirty() const noexcept
+{
+    return this->write_cursor - this->retired;
+}
+
+
+mmap::status_code
+mmap::stream_writer::start_window
+(
+    const size_type offset,
+    const size_type length
+) noexcept
+{
+    sys::file::status_code writeback_status = sys::file::writeback
+    (
+        this->origin.descriptor(),
+        this->origin.offset() + offset,
+        length,
+        SYNC_FILE_RANGE_WRITE
+    );
+    if (writeback_status == mmap::INTERNAL_ERROR_CODE)
+    {
+        util::log::record
+        (
+            "Unable to start writeback of stream window",
+            util::log::type::ERROR
+        );
+
+        return mmap::EXTERNAL_ERROR_CODE;
+    }
+
+    return mmap::GLOBAL_SUCCESS_CODE;
+}
+
+mmap::status_code
+mmap::stream_writer::retire_window
+(
+    const size_type offset,
+    const size_type length
+) noexcept
+{
+    // Wait for writeback, including writes queued by anyone else
+    sys::file::status_code writeback_status = sys::file::writeback
+    (
+        this->origin.descriptor(),
+        this->origin.offset() + offset,
+        length,
+        SYNC_FILE_RANGE_WAIT_BEFORE | SYNC_FILE_RANGE_WRITE | SYNC_FILE_RANGE_WAIT_AFTER
+    );
+    if (writeback_status == mmap::INTERNAL_ERROR_CODE)
+    {
+        util::log::record
+        (
+            "Unable to complete writeback of stream window",
+            util::log::type::ERROR
+        );
+
+        return mmap::EXTERNAL_ERROR_CODE;
+    }
+
+    // Clean pages now; unmapping them bounds resident memory. Windows
+    // after a finish may start mid page, already dropped with the last
+    const size_type page_size = sys::memory::page_size;
+    const size_type first     = (offset + page_size - 1) / page_size * page_size;
+    if (first >= offset + length)
+        return mmap::GLOBAL_SUCCESS_CODE;
+
+    sys::memory::status_code advise_status = sys::memory::advise
+    (
+        static_cast<std::uint8_t *>(this->origin.address()) + first,
+        offset + length - first,
+        MADV_DONTNEED
+    );
+    if (advise_status == mmap::INTERNAL_ERROR_CODE)
+    {
+        util::log::record
+        (
+            "Unable to drop retired stream window",
+            util::log::type::FLAG
+        );
+    }
+
+    return mmap::GLOBAL_SUCCESS_CODE;
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "file/file.hpp"
+
+
+namespace mmap
+{
+
+// Sequential writer over a shared mapping that keeps dirty memory bounded:
+// completed windows behind the cursor are queued for writeback, and the
+// oldest are waited on and dropped from the mapping once too many are
+// in flight. One writer thread per instance.
+class stream_writer
+{
+protected:
+    // Shared mapping being written
+    file      &origin;
+
+    // User provided metadata
+    size_type  window_bytes;
+    size_type  window_count;
+
+    // Byte positions in mapping: started <= cursor, retired <= started
+    size_type  write_cursor = 0;
+    size_type  started      = 0;
+    size_type  retired      = 0;
+
+public:
+    stream_writer
+    (
+        // Required parameters
+        file            &origin,
+
+        // Advanced parameters
+        const size_type  window_bytes = 8 << 20,
+        const size_type  window_count = 4
+    );
+
+    virtual ~stream_writer() noexcept = default;
+
+    // No copies permitted
+    stream_writer(const stream_writer &other)           = delete;
+    stream_writer operator=(const stream_writer &other) = delete;
+
+    // Copy at cursor and advance
+    status_code
+    write
+    (
+        const void      *source,
+        const size_type  length
+    ) noexcept;
+
+    // Report bytes written directly into the mapping up to cursor
+    status_code
+    advance
+    (
+        const size_type cursor
+    ) noexcept;
+
+    // Write back and drop everything below cursor; not a durability
+    // barrier, which still needs a flush
+    status_code
+    finish() noexcept;
+
+    size_type
+    cursor() const noexcept;
+    // Bytes written but not yet retired
+    size_type
+    dirty() const noexcept;
+
+protected:
+    status_code
+    start_window
+    (
+        const size_type offset,
+        const size_type length
+    ) noexcept;
+    status_code
+    retire_window
+    (
+        const size_type offset,
+        const size_type length
+    ) noexcept;
+};
+
+} // mmap namespace
@@ -0,0 +1,172 @@
+#include <exception>
+#include <utility>
+
+#include "pool.hpp"
+#include "record.hpp"
+
+
+/**
+ *  @brief Thread Pool Constructor
+ *
+ *  @param worker_count: number of worker threads, at least one
+ *
+ *  @details Start workers immediately; each waits on the task queue
+ *  until the pool is destroyed. If a worker cannot be started, those
+ *  already running are joined and the error is rethrown.
+ */
+util::thread::pool::pool
+(
+    const std::size_t worker_count
+)
+{
+    const std::size_t count = worker_count ? worker_count : 1;
+
+    try
+    {
+        this->workers.reserve(count);
+        for (std::size_t index = 0; index < count; ++index)
+            this->workers.emplace_back(&util::thread::pool::run, this);
+    }
+
+    // Destructor will not run; stop workers already started
+    catch (...)
+    {
+        {
+            std::unique_lock<std::mutex> lock(this->mutex);
+            this->stopping = true;
+        }
+        this->available.notify_all();
+
+        for (std::thread &worker: this->workers)
+            worker.join();
+
+        throw;
+    }
+}
+
+/**
+ *  @brief Thread Pool Destructor
+ *
+ *  @details Finish queued tasks, then stop and join every worker.
+ */
+util::thread::pool::~pool() noexcept
+{
+    {
+        std::unique_lock<std::mutex> lock(this->mutex);
+        this->stopping = true;
+    }
+    this->available.notify_all();
+
+    for (std::thread &worker: this->workers)
+    {
+        if (worker.joinable())
+            worker.join();
+    }
+}
+
+
+/**
+ *  @brief Submit Task
+ *
+ *  @param task: R-value callable run once by a worker
+ *
+ *  @details Queue task for the next free worker; fails only when the
+ *  pool is stopping or the queue cannot grow.
+ */
+bool
+util::thread::pool::submit
+(
+    task_t &&task
+) noexcept
+{
+    try
+    {
+        std::unique_lock<std::mutex> lock(this->mutex);
+        if (this->stopping)
+            return false;
+
+        this->tasks.push_back(std::move(task));
+    }
+
+    catch (const std::exception &exception)
+    {
+        return false;
+    }
+
+    this->available.notify_one();
+    return true;
+}
+
+/**
+ *  @brief Wait for Pool
+ *
+ *  @details Block until every queued task has run to completion.
+ */
+void
+util::thread::pool::wait() noexcept
+{
+    std::unique_lock<std::mutex> lock(this->mutex);
+    this->idle.wait
+    (
+        lock,
+        [this]() { return this->tasks.empty() && this->active == 0; }
+    );
+}
+
+std::size_t
+util::thread::pool::size() const noexcept
+{
+    return this->workers.size();
+}
+
+
+/**
+ *  @brief Worker Loop
+ *
+ *  @details Pop and run tasks until stopped with an empty queue; task
+ *  exceptions are recorded and do not take the worker down.
+ */
+void
+util::thread::pool::run() noexcept
+{
+    for (;;)
+    {
+        task_t task;
+        {
+            std::unique_lock<std::mutex> lock(this->mutex);
+            this->available.wait
+            (
+                lock,
+                [this]() { return this->stopping || !this->tasks.empty(); }
+            );
+
+            if (this->tasks.empty())
+                return;
+
+            task = std::move(this->tasks.front());
+            this->tasks.pop_front();
+            ++this->active;
+        }
+
+        try
+        {
+            task();
+        }
+
+        catch (const std::exception &exception)
+        {
+            util::log::record
+            (
+                "Thread pool task failed: " + std::string(exception.what()),
+                util::log::type::ERROR
+            );
+        }
+
+        {
+            std::unique_lock<std::mutex> lock(this->mutex);
+            --this->active;
+            if (this->tasks.empty() && this->active == 0)
+                this->idle.notify_all();
+        }
+    }
+}
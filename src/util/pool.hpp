@@ -0,0 +1,72 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+/**
+ *  @brief Thread Pool Utility Header
+ *
+ *  @details Defines a fixed size worker pool for running blocking
+ *  system call work off the calling thread
+ */
+namespace util
+{
+
+namespace thread
+{
+
+using task_t = std::function<void()>;
+
+class pool
+{
+private:
+    std::vector<std::thread> workers;
+    std::deque<task_t>       tasks;
+
+    std::mutex               mutex;
+    std::condition_variable  available;
+    std::condition_variable  idle;
+
+    std::size_t              active   = 0;
+    bool                     stopping = false;
+
+public:
+    explicit pool
+    (
+        const std::size_t worker_count
+    );
+
+    ~pool() noexcept;
+
+    // No copies permitted
+    pool(const pool &other)           = delete;
+    pool operator=(const pool &other) = delete;
+
+    // Queue task for next free worker
+    bool
+    submit
+    (
+        task_t &&task
+    ) noexcept;
+
+    // Block until queue is drained and workers are idle
+    void
+    wait() noexcept;
+
+    std::size_t
+    size() const noexcept;
+
+private:
+    void
+    run() noexcept;
+};
+
+} // thread namespace
+
+} // util namespace
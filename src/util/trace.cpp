@@ -0,0 +1,380 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+
+#include <sys/syscall.h>
+
+#if defined(__x86_64__)
+#include <x86intrin.h>
+#endif
+
+#include <lib/file.hpp>
+#include <lib/mmap.hpp>
+
+#include "record.hpp"
+#include "trace.hpp"
+
+
+namespace
+{
+
+// Mapped trace and the addresses of its sections
+struct recorder
+{
+    std::uint8_t           *base;
+    std::size_t             length;
+    util::trace::header    *header;
+    util::trace::region    *regions;
+    util::trace::record    *records;
+    std::uint64_t           generation;
+};
+
+recorder                   instance;
+std::atomic<recorder *>    active{nullptr};
+std::atomic<std::uint64_t> generation{0};
+
+// Threads arriving while every region is busy record nothing
+constexpr std::uint64_t NO_REGION = UINT64_MAX;
+
+// Region held by this thread in the current trace, freed on thread exit
+struct lease
+{
+    std::uint64_t region     = NO_REGION;
+    std::uint64_t generation = 0;
+
+    ~lease() noexcept
+    {
+        recorder *current = active.load(std::memory_order_acquire);
+        if (current && current->generation == this->generation && this->region != NO_REGION)
+            current->regions[this->region].busy.store(0, std::memory_order_release);
+    }
+};
+
+thread_local lease thread_lease;
+
+// Take a never used region, else one freed by an exited thread
+std::uint64_t
+claim
+(
+    recorder &current
+) noexcept
+{
+    util::trace::header &header = *current.header;
+    const std::uint64_t  thread = ::syscall(SYS_gettid);
+
+    if (header.next_region.load(std::memory_order_relaxed) < header.region_count)
+    {
+        const std::uint64_t fresh = header.next_region.fetch_add(1, std::memory_order_relaxed);
+        if (fresh < header.region_count)
+        {
+            util::trace::region &region = current.regions[fresh];
+            region.busy.store(1, std::memory_order_relaxed);
+            region.owner_start.store(0, std::memory_order_relaxed);
+            region.thread.store(thread, std::memory_order_relaxed);
+
+            return fresh;
+        }
+    }
+
+    for (std::uint64_t index = 0; index < header.region_count; ++index)
+    {
+        util::trace::region &region = current.regions[index];
+        std::uint64_t        free   = 0;
+        if (region.busy.load(std::memory_order_relaxed)
+            || !region.busy.compare_exchange_strong(free, 1, std::memory_order_acquire))
+            continue;
+
+        // Earlier owner keeps its records until they are overwritten
+        region.previous_thread.store(region.thread.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        region.previous_start.store(region.owner_start.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        region.owner_start.store(region.cursor.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        region.thread.store(thread, std::memory_order_relaxed);
+
+        return index;
+    }
+
+    return NO_REGION;
+}
+
+/**
+ *  @brief Cheap Tick Counter
+ *
+ *  @details Time stamp counter where available, monotonic nanoseconds
+ *  otherwise; converted to time only when decoding.
+ */
+inline std::uint64_t
+ticks() noexcept
+{
+#if defined(__x86_64__)
+    return __rdtsc();
+#else
+    return std::chrono::duration_cast<std::chrono::nanoseconds>
+    (
+        std::chrono::steady_clock::now().time_since_epoch()
+    ).count();
+#endif
+}
+
+inline std::uint64_t
+nanoseconds() noexcept
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>
+    (
+        std::chrono::steady_clock::now().time_since_epoch()
+    ).count();
+}
+
+inline std::size_t
+align
+(
+    const std::size_t size,
+    const std::size_t alignment
+) noexcept
+{
+    return (size + alignment - 1) / alignment * alignment;
+}
+
+} // anonymous namespace
+
+
+/**
+ *  @brief Open Trace
+ *
+ *  @param path:                 trace file path, truncated if present
+ *  @param [opt] region_count:   circular regions, one per thread
+ *  @param [opt] region_records: records each region holds before wrapping
+ *
+ *  @details Size and map the trace file, calibrate the tick counter
+ *  against the monotonic clock, then publish the trace to recording
+ *  threads. A region has one writer at a time and is freed when its
+ *  thread exits; threads finding every region busy are not recorded and
+ *  their events are counted in the header instead.
+ */
+bool
+util::trace::open
+(
+    const std::string &path,
+    const std::size_t  region_count,
+    const std::size_t  region_records
+) noexcept
+{
+    util::trace::close();
+    if (!region_count || !region_records)
+        return false;
+
+    // Layout: header, region table, name table, then page aligned records
+    const std::size_t page_size      = sys::memory::page_size;
+    const std::size_t regions_offset = align(sizeof(util::trace::header), alignof(util::trace::region));
+    const std::size_t names_offset   = regions_offset + region_count * sizeof(util::trace::region);
+    const std::size_t data_offset    = align
+    (
+        names_offset + util::trace::NAME_COUNT * util::trace::NAME_LENGTH,
+        page_size
+    );
+    const std::size_t length = data_offset
+        + region_count * region_records * sizeof(util::trace::record);
+
+    sys::file::descriptor descriptor = sys::file::open
+    (
+        path.c_str(),
+        O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC,
+        0666
+    );
+    if (descriptor == -1)
+    {
+        util::log::record
+        (
+            "Unable to open trace file",
+            util::log::type::ERROR
+        );
+
+        return false;
+    }
+
+    if (sys::file::resize(descriptor, length) == -1)
+    {
+        util::log::record
+        (
+            "Unable to size trace file",
+            util::log::type::ERROR
+        );
+
+        sys::file::close(descriptor);
+        return false;
+    }
+
+    void *address = sys::memory::map
+    (
+        nullptr,
+        length,
+        PROT_READ | PROT_WRITE,
+        MAP_SHARED,
+        descriptor,
+        0
+    );
+    sys::file::close(descriptor);
+    if (address == MAP_FAILED)
+    {
+        util::log::record
+        (
+            "Unable to map trace file",
+            util::log::type::ERROR
+        );
+
+        return false;
+    }
+
+    // Calibrate ticks over a short spin
+    const std::uint64_t start_ticks       = ticks();
+    const std::uint64_t start_nanoseconds = nanoseconds();
+    while (nanoseconds() - start_nanoseconds < 2'000'000);
+    const std::uint64_t stop_ticks        = ticks();
+    const std::uint64_t stop_nanoseconds  = nanoseconds();
+
+    std::uint8_t        *base   = static_cast<std::uint8_t *>(address);
+    util::trace::header *header = reinterpret_cast<util::trace::header *>(base);
+    header->magic                = util::trace::MAGIC;
+    header->version              = util::trace::VERSION;
+    header->record_size          = sizeof(util::trace::record);
+    header->region_count         = region_count;
+    header->region_records       = region_records;
+    header->regions_offset       = regions_offset;
+    header->names_offset         = names_offset;
+    header->data_offset          = data_offset;
+    header->origin_ticks         = stop_ticks;
+    header->origin_nanoseconds   = stop_nanoseconds;
+    header->ticks_per_nanosecond = static_cast<double>(stop_ticks - start_ticks)
+        / static_cast<double>(stop_nanoseconds - start_nanoseconds);
+
+    instance.base       = base;
+    instance.length     = length;
+    instance.header     = header;
+    instance.regions    = reinterpret_cast<util::trace::region *>(base + regions_offset);
+    instance.records    = reinterpret_cast<util::trace::record *>(base + data_offset);
+    instance.generation = generation.fetch_add(1, std::memory_order_relaxed) + 1;
+
+    active.store(&instance, std::memory_order_release);
+
+    return true;
+}
+
+/**
+ *  @brief Close Trace
+ *
+ *  @details Stop recording and unmap; recording threads must be idle,
+ *  as an event in flight would write to the unmapped file.
+ */
+void
+util::trace::close() noexcept
+{
+    recorder *current = active.exchange(nullptr, std::memory_order_acq_rel);
+    if (!current)
+        return;
+
+    sys::memory::sync(current->base, current->length, MS_ASYNC);
+    sys::memory::unmap(current->base, current->length);
+}
+
+/**
+ *  @brief Name Event
+ *
+ *  @param event: event id
+ *  @param label: name shown by decoder, truncated to fit
+ *
+ *  @details Store label in trace name table so decoded traces are
+ *  readable without the recording binary.
+ */
+void
+util::trace::name
+(
+    const std::uint16_t  event,
+    const std::string   &label
+) noexcept
+{
+    recorder *current = active.load(std::memory_order_acquire);
+    if (!current || event >= util::trace::NAME_COUNT)
+        return;
+
+    char *slot = reinterpret_cast<char *>(current->base + current->header->names_offset)
+        + event * util::trace::NAME_LENGTH;
+
+    const std::size_t length = std::min(label.size(), util::trace::NAME_LENGTH - 1);
+    std::memcpy(slot, label.data(), length);
+    slot[length] = '\0';
+}
+
+/**
+ *  @brief Record Event
+ *
+ *  @param event:          event id
+ *  @param [opt] type:     trace phase
+ *  @param [opt] argument: first argument
+ *  @param [opt] extra:    second argument
+ *
+ *  @details Write one record into this thread's region, publishing it
+ *  by storing its sequence last so partial records left by a crash are
+ *  recognized and skipped.
+ */
+void
+util::trace::event
+(
+    const std::uint16_t event,
+    const phase         type,
+    const std::uint64_t argument,
+    const std::uint64_t extra
+) noexcept
+{
+    recorder *current = active.load(std::memory_order_acquire);
+    if (!current)
+        return;
+
+    const util::trace::header &header = *current->header;
+
+    // First event of this thread in this trace claims a region; threads
+    // left without one retry, as exiting threads free theirs
+    lease &held = thread_lease;
+    if (held.generation != current->generation || held.region == NO_REGION)
+    {
+        held.generation = current->generation;
+        held.region     = claim(*current);
+    }
+
+    // Sharing a region would mix thread ids and race on slots
+    if (held.region == NO_REGION)
+    {
+        current->header->dropped_events.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    const std::uint64_t thread_region = held.region;
+
+    util::trace::region &region   = current->regions[thread_region];
+    const std::uint64_t  position = region.cursor.fetch_add(1, std::memory_order_relaxed);
+
+    util::trace::record &slot = current->records
+    [
+        thread_region * header.region_records + position % header.region_records
+    ];
+    slot.ticks        = ticks();
+    slot.event        = event;
+    slot.type         = type;
+    slot.arguments[0] = argument;
+    slot.arguments[1] = extra;
+    slot.sequence.store(static_cast<std::uint32_t>(position + 1), std::memory_order_release);
+}
+
+
+util::trace::scope::scope
+(
+    const std::uint16_t event,
+    const std::uint64_t argument
+) noexcept
+{
+    this->scope_event = event;
+    util::trace::event(event, phase::BEGIN, argument);
+}
+
+util::trace::scope::~scope() noexcept
+{
+    util::trace::event(this->scope_event, phase::END);
+}
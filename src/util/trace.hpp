@@ -0,0 +1,139 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+
+/**
+ *  @brief Trace Utility Header
+ *
+ *  @details Defines a binary flight recorder: fixed size event records
+ *  written into per-thread circular regions of a mapped file, cheap
+ *  enough to leave on for hot paths and readable after a crash
+ */
+namespace util
+{
+
+namespace trace
+{
+
+// Chrome trace phases
+enum class phase: std::uint8_t
+{
+    INSTANT = 'i',
+    BEGIN   = 'B',
+    END     = 'E',
+    COUNTER = 'C'
+};
+
+constexpr std::uint64_t MAGIC        = 0x4543415254504d4d;  // "MMPTRACE"
+constexpr std::uint32_t VERSION      = 3;
+constexpr std::size_t   NAME_COUNT   = 1024;
+constexpr std::size_t   NAME_LENGTH  = 32;
+
+// File header; offsets are from start of file
+struct header
+{
+    std::uint64_t              magic;
+    std::uint32_t              version;
+    std::uint32_t              record_size;
+    std::uint64_t              region_count;
+    std::uint64_t              region_records;
+    std::uint64_t              regions_offset;
+    std::uint64_t              names_offset;
+    std::uint64_t              data_offset;
+
+    // Tick calibration taken at open
+    std::uint64_t              origin_ticks;
+    std::uint64_t              origin_nanoseconds;
+    double                     ticks_per_nanosecond;
+
+    std::atomic<std::uint64_t> next_region;
+
+    // Events from threads that found every region busy
+    std::atomic<std::uint64_t> dropped_events;
+};
+
+// Per-thread write cursor; counts every record ever written to region.
+// Each region has one writing thread at a time; an exiting thread frees
+// it for the next, and positions from owner_start on belong to thread,
+// those from previous_start up to owner_start to previous_thread
+struct alignas(64) region
+{
+    std::atomic<std::uint64_t> cursor;
+    std::atomic<std::uint64_t> thread;
+    std::atomic<std::uint64_t> busy;
+    std::atomic<std::uint64_t> owner_start;
+    std::atomic<std::uint64_t> previous_thread;
+    std::atomic<std::uint64_t> previous_start;
+};
+
+// Sequence is written last; a record is whole when it matches its slot
+struct record
+{
+    std::uint64_t              ticks;
+    std::atomic<std::uint32_t> sequence;
+    std::uint16_t              event;
+    phase                      type;
+    std::uint8_t               reserved;
+    std::uint64_t              arguments[2];
+};
+
+static_assert(sizeof(record) == 32, "Trace records must stay 32 bytes");
+
+// Map trace file and start recording; replaces any previous trace
+bool
+open
+(
+    const std::string &path,
+    const std::size_t  region_count   = 64,
+    const std::size_t  region_records = 1 << 16
+) noexcept;
+
+// Stop recording and unmap
+void
+close() noexcept;
+
+// Name an event id for decoding
+void
+name
+(
+    const std::uint16_t  event,
+    const std::string   &label
+) noexcept;
+
+// Record one event; no-op while no trace is open, counted as dropped
+// while more live threads record than there are regions
+void
+event
+(
+    const std::uint16_t event,
+    const phase         type     = phase::INSTANT,
+    const std::uint64_t argument = 0,
+    const std::uint64_t extra    = 0
+) noexcept;
+
+// Begin event on construction, end event on destruction
+class scope
+{
+private:
+    std::uint16_t scope_event;
+
+public:
+    explicit scope
+    (
+        const std::uint16_t event,
+        const std::uint64_t argument = 0
+    ) noexcept;
+
+    ~scope() noexcept;
+
+    // No copies permitted
+    scope(const scope &other)           = delete;
+    scope operator=(const scope &other) = delete;
+};
+
+} // trace namespace
+
+} // util namespace
@@ -0,0 +1,267 @@
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <lib/file.hpp>
+#include <lib/mmap.hpp>
+
+#include "trace.hpp"
+
+
+namespace
+{
+
+// Whole record lifted out of a region
+struct decoded
+{
+    double        nanoseconds;
+    std::uint64_t thread;
+    std::uint16_t event;
+    char          type;
+    std::uint64_t arguments[2];
+};
+
+/**
+ *  @brief Event Label
+ *
+ *  @details Name from trace name table, or the numeric id when unnamed.
+ */
+std::string
+label
+(
+    const std::uint8_t        *base,
+    const util::trace::header &header,
+    const std::uint16_t        event
+)
+{
+    if (event < util::trace::NAME_COUNT)
+    {
+        const char *name = reinterpret_cast<const char *>(base + header.names_offset)
+            + event * util::trace::NAME_LENGTH;
+        if (name[0])
+            return std::string(name, strnlen(name, util::trace::NAME_LENGTH));
+    }
+
+    return "event_" + std::to_string(event);
+}
+
+/**
+ *  @brief Section Fits
+ *
+ *  @details Whether count items of size bytes starting at offset lie
+ *  within a file of length bytes, without overflowing on corrupt fields.
+ */
+bool
+fits
+(
+    const std::uint64_t offset,
+    const std::uint64_t count,
+    const std::uint64_t size,
+    const std::uint64_t length
+)
+{
+    if (offset > length || (size && count > (length - offset) / size))
+        return false;
+
+    return true;
+}
+
+/**
+ *  @brief Escape JSON String
+ */
+std::string
+escape
+(
+    const std::string &text
+)
+{
+    std::string escaped;
+    for (const char character: text)
+    {
+        if (character == '"' || character == '\\')
+            escaped += '\\';
+        escaped += character;
+    }
+
+    return escaped;
+}
+
+} // anonymous namespace
+
+
+/**
+ *  @brief Trace Decoder
+ *
+ *  @details Read a trace file left by util::trace, including one from a
+ *  crashed process, and print its whole records in time order as text,
+ *  or as Chrome trace JSON with --chrome.
+ *
+ *  Usage: trace_decode <trace file> [--chrome]
+ */
+int
+main
+(
+    int    argc,
+    char **argv
+)
+{
+    if (argc < 2)
+    {
+        std::cerr << "Usage: " << argv[0] << " <trace file> [--chrome]" << std::endl;
+        return EXIT_FAILURE;
+    }
+    const bool chrome = argc > 2 && std::strcmp(argv[2], "--chrome") == 0;
+
+    // Map trace read only
+    sys::file::descriptor descriptor = sys::file::open(argv[1], O_RDONLY | O_CLOEXEC);
+    struct stat status;
+    if (descriptor == -1 || sys::file::status(descriptor, &status) == -1
+        || static_cast<std::size_t>(status.st_size) < sizeof(util::trace::header))
+    {
+        std::cerr << "Unable to open trace file: " << argv[1] << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    void *address = sys::memory::map
+    (
+        nullptr,
+        status.st_size,
+        PROT_READ,
+        MAP_SHARED,
+        descriptor,
+        0
+    );
+    sys::file::close(descriptor);
+    if (address == MAP_FAILED)
+    {
+        std::cerr << "Unable to map trace file: " << argv[1] << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // Every section must lie inside the file; a crashed writer may have
+    // left any field damaged
+    const std::uint8_t        *base   = static_cast<const std::uint8_t *>(address);
+    const util::trace::header &header = *reinterpret_cast<const util::trace::header *>(base);
+    const std::uint64_t        length = status.st_size;
+    const bool valid = header.magic == util::trace::MAGIC
+        && header.version == util::trace::VERSION
+        && header.record_size == sizeof(util::trace::record)
+        && header.region_records
+        && header.region_count <= length / sizeof(util::trace::region)
+        && fits(header.regions_offset, header.region_count, sizeof(util::trace::region), length)
+        && fits(header.names_offset, util::trace::NAME_COUNT, util::trace::NAME_LENGTH, length)
+        && header.region_count <= length / sizeof(util::trace::record) / header.region_records
+        && fits
+        (
+            header.data_offset,
+            header.region_count * header.region_records,
+            sizeof(util::trace::record),
+            length
+        )
+        && header.regions_offset % alignof(util::trace::region) == 0
+        && header.data_offset % alignof(util::trace::record) == 0;
+    if (!valid)
+    {
+        std::cerr << "Not a trace file or unsupported version: " << argv[1] << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    const util::trace::region *regions = reinterpret_cast<const util::trace::region *>
+    (
+        base + header.regions_offset
+    );
+    const util::trace::record *records = reinterpret_cast<const util::trace::record *>
+    (
+        base + header.data_offset
+    );
+
+    // Keep the last full lap of each region whose sequence matches its
+    // slot, back to the owner before the current one
+    std::vector<decoded> events;
+    for (std::size_t index = 0; index < header.region_count; ++index)
+    {
+        const util::trace::region &region = regions[index];
+        const std::uint64_t cursor          = region.cursor.load(std::memory_order_acquire);
+        const std::uint64_t owner_start     = region.owner_start.load(std::memory_order_relaxed);
+        const std::uint64_t previous_start  = region.previous_start.load(std::memory_order_relaxed);
+        const std::uint64_t first           = std::max
+        (
+            cursor > header.region_records ? cursor - header.region_records : 0,
+            std::min(previous_start, owner_start)
+        );
+
+        for (std::uint64_t position = first; position < cursor; ++position)
+        {
+            const util::trace::record &slot = records
+            [
+                index * header.region_records + position % header.region_records
+            ];
+            if (slot.sequence.load(std::memory_order_acquire) != static_cast<std::uint32_t>(position + 1))
+                continue;
+
+            const double elapsed = (static_cast<double>(slot.ticks) - static_cast<double>(header.origin_ticks))
+                / header.ticks_per_nanosecond;
+            events.push_back
+            ({
+                elapsed,
+                position >= owner_start
+                    ? region.thread.load(std::memory_order_relaxed)
+                    : region.previous_thread.load(std::memory_order_relaxed),
+                slot.event,
+                static_cast<char>(slot.type),
+                {slot.arguments[0], slot.arguments[1]}
+            });
+        }
+    }
+
+    const std::uint64_t dropped = header.dropped_events.load(std::memory_order_relaxed);
+    if (dropped)
+        std::cerr << dropped << " events dropped: more live threads than trace regions" << std::endl;
+
+    std::stable_sort
+    (
+        events.begin(),
+        events.end(),
+        [](const decoded &left, const decoded &right)
+        {
+            return left.nanoseconds < right.nanoseconds;
+        }
+    );
+
+    if (chrome)
+    {
+        std::cout << "{\"traceEvents\":[";
+        for (std::size_t index = 0; index < events.size(); ++index)
+        {
+            const decoded &event = events[index];
+            std::cout << (index ? ",\n" : "\n")
+                << "{\"name\":\"" << escape(label(base, header, event.event)) << "\""
+                << ",\"ph\":\"" << event.type << "\""
+                << ",\"ts\":" << std::fixed << std::setprecision(3) << event.nanoseconds / 1000.0
+                << ",\"pid\":1,\"tid\":" << event.thread;
+            if (event.type == static_cast<char>(util::trace::phase::INSTANT))
+                std::cout << ",\"s\":\"t\"";
+            std::cout << ",\"args\":{\"a0\":" << event.arguments[0]
+                << ",\"a1\":" << event.arguments[1] << "}}";
+        }
+        std::cout << "\n],\"displayTimeUnit\":\"ns\"}" << std::endl;
+    }
+
+    else
+    {
+        for (const decoded &event: events)
+        {
+            std::cout << std::fixed << std::setprecision(0) << std::setw(14) << event.nanoseconds
+                << " ns  tid " << std::setw(7) << event.thread
+                << "  " << event.type << "  " << label(base, header, event.event)
+                << "  " << event.arguments[0] << " " << event.arguments[1] << "\n";
+        }
+    }
+
+    sys::memory::unmap(address, status.st_size);
+
+    return EXIT_SUCCESS;
+}